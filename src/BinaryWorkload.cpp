@@ -0,0 +1,194 @@
+#include "BinaryWorkload.h"
+#include <fstream>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+#include <numeric>
+
+static const char BINARY_WORKLOAD_MAGIC[8] = {'S', 'C', 'H', 'E', 'D', 'W', 'K', 'L'};
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+bool isBinaryWorkload(const char* data, size_t size) {
+    return size >= sizeof(BINARY_WORKLOAD_MAGIC) && std::memcmp(data, BINARY_WORKLOAD_MAGIC, sizeof(BINARY_WORKLOAD_MAGIC)) == 0;
+}
+
+BinaryWorkloadView::BinaryWorkloadView(const std::string& filename)
+    : file(filename), count(0), flags(0), burstOffsets(nullptr), bursts(nullptr) {
+    if (file.size() < sizeof(BinaryWorkloadHeader) || !isBinaryWorkload(file.data(), file.size())) {
+        throw std::runtime_error("Not a binary workload file: " + filename);
+    }
+
+    BinaryWorkloadHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+        throw std::runtime_error("Unsupported byte order in binary workload: " + filename);
+    }
+    if (header.version < 1 || header.version > BINARY_WORKLOAD_VERSION) {
+        throw std::runtime_error("Unsupported binary workload version " + std::to_string(header.version) + " in: " + filename);
+    }
+    bool withBursts = header.version >= 2 && (header.flags & BINARY_WORKLOAD_BURSTS) != 0;
+
+    // The column and offset sizes are checked before anything past them is read
+    uint64_t available = file.size() - sizeof(header);
+    if (header.processCount > available / (4 * sizeof(int32_t) + (withBursts ? sizeof(uint64_t) : 0))) {
+        throw std::runtime_error("Truncated or oversized binary workload: " + filename);
+    }
+    count = static_cast<size_t>(header.processCount);
+    flags = header.flags;
+    const int32_t* column = reinterpret_cast<const int32_t*>(file.data() + sizeof(header));
+    for (int i = 0; i < 4; ++i) {
+        columns[i] = column + i * count;
+    }
+
+    uint64_t expected = 4 * sizeof(int32_t) * count;
+    if (withBursts) {
+        expected += (count + 1) * sizeof(uint64_t);
+        if (expected > available) throw std::runtime_error("Truncated or oversized binary workload: " + filename);
+        burstOffsets = reinterpret_cast<const uint64_t*>(column + 4 * count);
+        bursts = reinterpret_cast<const int32_t*>(burstOffsets + count + 1);
+        for (size_t i = 0; i < count; ++i) {
+            if (burstOffsets[i] > burstOffsets[i + 1] || (burstOffsets[i + 1] - burstOffsets[i]) % 2 != 0) {
+                throw std::runtime_error("Malformed burst offsets in binary workload: " + filename);
+            }
+        }
+        if (burstOffsets[0] != 0 || burstOffsets[count] > (available - expected) / sizeof(int32_t)) {
+            throw std::runtime_error("Truncated or oversized binary workload: " + filename);
+        }
+        expected += burstOffsets[count] * sizeof(int32_t);
+    }
+    if (expected != available) {
+        throw std::runtime_error("Truncated or oversized binary workload: " + filename);
+    }
+
+    // The values the text parser rejects are rejected here too, and a sorted flag must hold for toWorkload to trust it
+    for (size_t i = 0; i < count; ++i) {
+        const char* problem = nullptr;
+        if (arrivalTimes()[i] < 0) problem = "Arrival time must not be negative";
+        else if (burstTimes()[i] < 1) problem = "Burst time must be positive";
+        else if (sortedByArrival() && i > 0 && (arrivalTimes()[i] < arrivalTimes()[i - 1] ||
+                                                (arrivalTimes()[i] == arrivalTimes()[i - 1] && ids()[i] < ids()[i - 1]))) {
+            problem = "Processes are not ordered by arrival time and ID as flagged";
+        }
+        if (problem != nullptr) {
+            throw std::runtime_error(problem + (" for process " + std::to_string(i + 1) + " of binary workload: " + filename));
+        }
+    }
+    if (withBursts) {
+        for (uint64_t i = 0; i < burstOffsets[count]; ++i) {
+            if (bursts[i] < 1) {
+                throw std::runtime_error("I/O and CPU bursts after the priority must be positive in binary workload: " + filename);
+            }
+        }
+    }
+}
+
+std::vector<Process> BinaryWorkloadView::toProcesses() const {
+    std::vector<Process> processes;
+    processes.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        processes.emplace_back(ids()[i], arrivalTimes()[i], burstTimes()[i], priorities()[i]);
+        if (hasBursts()) processes.back().ioCpuBursts.assign(burstsOf(i), burstsOf(i + 1));
+    }
+    return processes;
+}
+
+Workload BinaryWorkloadView::toWorkload() const {
+    Workload workload;
+    bool withIo = hasBursts() && burstOffsets[count] > 0;
+    if (sortedByArrival()) {
+        workload.ids.assign(ids(), ids() + count);
+        workload.arrivalTimes.assign(arrivalTimes(), arrivalTimes() + count);
+        workload.burstTimes.assign(burstTimes(), burstTimes() + count);
+        workload.priorities.assign(priorities(), priorities() + count);
+        if (withIo) {
+            workload.burstOffsets.assign(burstOffsets, burstOffsets + count + 1);
+            workload.bursts.assign(bursts, bursts + burstOffsets[count]);
+        }
+        return workload;
+    }
+
+    // Gather every column through one permutation in (arrival time, ID) order
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    const int32_t* arrivals = arrivalTimes();
+    const int32_t* processIds = ids();
+    std::sort(order.begin(), order.end(), [arrivals, processIds](size_t a, size_t b) {
+        if (arrivals[a] != arrivals[b]) return arrivals[a] < arrivals[b];
+        return processIds[a] < processIds[b];
+    });
+
+    workload.ids.reserve(count);
+    workload.arrivalTimes.reserve(count);
+    workload.burstTimes.reserve(count);
+    workload.priorities.reserve(count);
+    for (size_t i : order) {
+        workload.ids.push_back(ids()[i]);
+        workload.arrivalTimes.push_back(arrivalTimes()[i]);
+        workload.burstTimes.push_back(burstTimes()[i]);
+        workload.priorities.push_back(priorities()[i]);
+    }
+    if (withIo) {
+        workload.burstOffsets.reserve(count + 1);
+        workload.burstOffsets.push_back(0);
+        workload.bursts.reserve(burstOffsets[count]);
+        for (size_t i : order) {
+            workload.bursts.insert(workload.bursts.end(), burstsOf(i), burstsOf(i + 1));
+            workload.burstOffsets.push_back(workload.bursts.size());
+        }
+    }
+    return workload;
+}
+
+std::vector<Process> loadBinaryWorkload(const std::string& filename) {
+    return BinaryWorkloadView(filename).toProcesses();
+}
+
+void saveBinaryWorkload(const std::string& filename, const std::vector<Process>& processes) {
+    std::ofstream outfile(filename, std::ios::binary | std::ios::trunc);
+    if (!outfile) {
+        throw std::runtime_error("Error opening file for writing: " + filename);
+    }
+
+    bool sorted = true;
+    for (size_t i = 1; i < processes.size() && sorted; ++i) {
+        const Process& a = processes[i - 1];
+        const Process& b = processes[i];
+        sorted = a.arrivalTime < b.arrivalTime || (a.arrivalTime == b.arrivalTime && a.id <= b.id);
+    }
+
+    bool withBursts = false;
+    for (const Process& p : processes) withBursts = withBursts || !p.ioCpuBursts.empty();
+
+    BinaryWorkloadHeader header;
+    std::memcpy(header.magic, BINARY_WORKLOAD_MAGIC, sizeof(header.magic));
+    header.version = withBursts ? 2 : 1;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.processCount = processes.size();
+    header.flags = (sorted ? BINARY_WORKLOAD_SORTED : 0) | (withBursts ? BINARY_WORKLOAD_BURSTS : 0);
+    header.reserved = 0;
+    outfile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Columnar layout: all IDs, then all arrival times, burst times and priorities
+    std::vector<int32_t> column(processes.size());
+    for (int field = 0; field < 4; ++field) {
+        for (size_t i = 0; i < processes.size(); ++i) {
+            const Process& p = processes[i];
+            column[i] = (field == 0) ? p.id : (field == 1) ? p.arrivalTime : (field == 2) ? p.burstTime : p.priority;
+        }
+        outfile.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(int32_t));
+    }
+
+    if (withBursts) {
+        std::vector<uint64_t> offsets(1, 0);
+        offsets.reserve(processes.size() + 1);
+        for (const Process& p : processes) offsets.push_back(offsets.back() + p.ioCpuBursts.size());
+        outfile.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+        for (const Process& p : processes) {
+            outfile.write(reinterpret_cast<const char*>(p.ioCpuBursts.data()), p.ioCpuBursts.size() * sizeof(int32_t));
+        }
+    }
+
+    if (!outfile) {
+        throw std::runtime_error("Error writing file: " + filename);
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef BINARY_WORKLOAD_H
+#define BINARY_WORKLOAD_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "Process.h"
+#include "Workload.h"
+#include "MappedFile.h"
+
+/**
+ * Newest version of the binary workload format. saveBinaryWorkload writes version 1 unless some process does I/O,
+ * so CPU-only files stay readable by older builds; version 2 adds the burst sections.
+ */
+const uint32_t BINARY_WORKLOAD_VERSION = 2;
+
+/** Flag bit set when the processes are already ordered by (arrival time, ID). */
+const uint32_t BINARY_WORKLOAD_SORTED = 1u << 0;
+
+/** Flag bit (version 2) set when the columns are followed by the burst sections. */
+const uint32_t BINARY_WORKLOAD_BURSTS = 1u << 1;
+
+/**
+ * Fixed 32-byte header at the start of a binary workload file.
+ * It is followed by four columns of processCount int32 values each, in this order:
+ * id, arrivalTime, burstTime, priority. With BINARY_WORKLOAD_BURSTS, processCount + 1 uint64 offsets follow, then
+ * the int32 I/O, CPU, ... bursts of every process (process i owns entries [offset i, offset i + 1)).
+ * All fields use the byte order recorded in byteOrder.
+ */
+struct BinaryWorkloadHeader {
+    char magic[8];          // "SCHEDWKL"
+    uint32_t version;       // BINARY_WORKLOAD_VERSION
+    uint32_t byteOrder;     // 0x01020304 as written by the producer
+    uint64_t processCount;
+    uint32_t flags;         // BINARY_WORKLOAD_* bits
+    uint32_t reserved;
+};
+
+static_assert(sizeof(BinaryWorkloadHeader) == 32, "Binary workload header must stay 32 bytes");
+
+/** True if the buffer starts with the binary workload magic. */
+bool isBinaryWorkload(const char* data, size_t size);
+
+/**
+ * Memory-mapped, read-only view of a binary workload.
+ * The columns point straight into the mapping, so opening a file costs a header check, not a parse.
+ * Throws runtime error if the file cannot be opened, has the wrong magic, an unsupported version or byte
+ * order, or a size that does not match the header, or if it holds a value the text format rejects (a negative
+ * arrival time, a burst below 1) or is flagged as sorted but is not.
+ */
+class BinaryWorkloadView {
+public:
+    explicit BinaryWorkloadView(const std::string& filename);
+
+    size_t size() const { return count; }
+    bool sortedByArrival() const { return (flags & BINARY_WORKLOAD_SORTED) != 0; }
+    const int32_t* ids() const { return columns[0]; }
+    const int32_t* arrivalTimes() const { return columns[1]; }
+    const int32_t* burstTimes() const { return columns[2]; }
+    const int32_t* priorities() const { return columns[3]; }
+    bool hasBursts() const { return burstOffsets != nullptr; }
+
+    /** Start of process i's I/O, CPU, ... bursts; burstsOf(i + 1) is its end. Only valid if hasBursts(). */
+    const int32_t* burstsOf(size_t i) const { return bursts + burstOffsets[i]; }
+
+    /** Builds Process objects in file order (e.g. to convert the file back to text). */
+    std::vector<Process> toProcesses() const;
+
+    /**
+     * Copies the columns straight into a Workload. A file flagged as sorted is copied as is; otherwise the
+     * columns are gathered in (arrival time, ID) order, as Workload(std::vector<Process>) would sort them.
+     */
+    Workload toWorkload() const;
+
+private:
+    MappedFile file;
+    size_t count;
+    uint32_t flags;
+    const int32_t* columns[4];
+    const uint64_t* burstOffsets;
+    const int32_t* bursts;
+};
+
+/** Loads a binary workload file into Process objects. Throws runtime error on any format problem. */
+std::vector<Process> loadBinaryWorkload(const std::string& filename);
+
+/** Writes processes to a binary workload file in their given order. Throws runtime error if the file cannot be written. */
+void saveBinaryWorkload(const std::string& filename, const std::vector<Process>& processes);
+
+#endif
@@ -0,0 +1,215 @@
+#include "CommandLine.h"
+#include <iostream>
+#include <stdexcept>
+
+CommandLineOptions::CommandLineOptions() : mlfqConfig(MlfqConfig::fromParameters(MlfqParameters())) {
+    sweepConfig.roundRobinQuanta = {4};
+    sweepConfig.mlfqQuantumQ0 = {MlfqParameters().quantumQ0};
+    sweepConfig.mlfqQuantumQ1 = {MlfqParameters().quantumQ1};
+    sweepConfig.mlfqAgingThreshold = {MlfqParameters().agingThreshold};
+}
+
+/** --rr-quantum alone is the quantum of a streamed Round Robin run, not a sweep. */
+RunMode CommandLineOptions::mode() const {
+    if (!streamAlgorithm.empty()) return RunMode::Stream;
+    if (replicas > 0) return RunMode::Replicas;
+    if (!whatIfEdits.empty()) return RunMode::WhatIf;
+    if (sweep || roundRobinListSet || mlfqListSet) return RunMode::Sweep;
+    return RunMode::Compare;
+}
+
+void CommandLineOptions::validate() const {
+    if (!unexpected.empty()) throw std::runtime_error("Unexpected argument: " + unexpected);
+
+    // The workload is a process file or the generator's output
+    if (filename.empty() == !generate) throw std::runtime_error("Give either a process file or --generate");
+    if (generatorOptionUsed && !generate) throw std::runtime_error("Generator options need --generate");
+    if (seedSet && !generate && replicas == 0) throw std::runtime_error("--seed needs --generate or --replicas");
+
+    bool sweepRequested = sweep || mlfqListSet || (roundRobinListSet && streamAlgorithm.empty());
+    int modes = !streamAlgorithm.empty() + !whatIfEdits.empty() + (replicas > 0) + sweepRequested;
+    if (modes > 1) throw std::runtime_error("--stream, --what-if, --replicas and --sweep (or a sweep list) select different modes; give at most one");
+
+    RunMode selected = mode();
+    if (multiCoreSet && selected != RunMode::Compare) throw std::runtime_error("--cpus and --migration-cost only apply to the comparison");
+    if (snapshotInterval > 0 && selected != RunMode::Stream) throw std::runtime_error("--snapshot-interval needs --stream");
+    if (checkpointInterval > 0 && selected != RunMode::WhatIf) throw std::runtime_error("--checkpoint-interval needs --what-if");
+    if (replicaModelSet && selected != RunMode::Replicas) throw std::runtime_error("--replica-model needs --replicas");
+
+    switch (selected) {
+        case RunMode::Compare:
+            break;
+        case RunMode::Stream:
+            if (sweepConfig.roundRobinQuanta.size() > 1) throw std::runtime_error("--stream runs a single --rr-quantum");
+            break;
+        case RunMode::Sweep:
+            if (!traceFile.empty()) throw std::runtime_error("--trace does not apply to a sweep");
+            if (showStats) throw std::runtime_error("--stats does not apply to a sweep");
+            // The sweep builds its own three-level MLFQ from --mlfq-q0, --mlfq-q1 and --mlfq-aging, and runs no CFS
+            if (mlfqConfigSet) throw std::runtime_error("--mlfq-config does not apply to a sweep; use --mlfq-q0, --mlfq-q1 and --mlfq-aging");
+            if (cfsParametersSet) throw std::runtime_error("--cfs-latency and --cfs-granularity do not apply to a sweep");
+            break;
+        case RunMode::WhatIf:
+            if (!traceFile.empty()) throw std::runtime_error("--trace does not apply to --what-if");
+            if (showStats) throw std::runtime_error("--stats does not apply to --what-if");
+            break;
+        case RunMode::Replicas:
+            if (!traceFile.empty()) throw std::runtime_error("--trace does not apply to --replicas");
+            if (showStats) throw std::runtime_error("--stats does not apply to --replicas");
+            if (replicaModelSet && generate) throw std::runtime_error("--replica-model applies to replicas of a process file, not to --generate");
+            break;
+    }
+}
+
+CommandLineOptions parseCommandLine(int argc, char* argv[]) {
+    CommandLineOptions options;
+    bool preemptionCostSet = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--sweep") {
+            options.sweep = true;
+            continue;
+        }
+        if (arg == "--generate") {
+            options.generate = true;
+            continue;
+        }
+        if (arg == "--stats") {
+#ifdef SCHEDULER_STATS
+            options.showStats = true;
+            continue;
+#else
+            throw std::runtime_error("--stats needs a build configured with -DSCHEDULER_STATS=ON");
+#endif
+        }
+        if (arg.compare(0, 2, "--") != 0) {
+            if (!options.filename.empty()) {
+                options.unexpected = arg;
+                break;
+            }
+            options.filename = arg;
+            continue;
+        }
+        if (i + 1 == argc) {
+            options.unexpected = arg;
+            break;
+        }
+        std::string value = argv[++i];
+
+        std::vector<int>* sweepList = nullptr;
+        if (arg == "--rr-quantum") sweepList = &options.sweepConfig.roundRobinQuanta;
+        else if (arg == "--mlfq-q0") sweepList = &options.sweepConfig.mlfqQuantumQ0;
+        else if (arg == "--mlfq-q1") sweepList = &options.sweepConfig.mlfqQuantumQ1;
+        else if (arg == "--mlfq-aging") sweepList = &options.sweepConfig.mlfqAgingThreshold;
+
+        if (sweepList != nullptr) {
+            try {
+                *sweepList = parseParameterList(value);
+            } catch (const std::runtime_error& e) {
+                throw std::runtime_error(arg + ": " + e.what());
+            }
+            if (arg == "--rr-quantum") options.roundRobinListSet = true;
+            else options.mlfqListSet = true;
+        } else if (arg == "--mlfq-config") {
+            try {
+                options.mlfqConfig = loadMlfqConfigFromFile(value);
+            } catch (const std::runtime_error& e) {
+                throw std::runtime_error(std::string("Failed to load MLFQ configuration: ") + e.what());
+            }
+            options.mlfqConfigSet = true;
+        } else if (arg == "--stream") {
+            options.streamAlgorithm = value;
+        } else if (arg == "--snapshot-interval") {
+            options.snapshotInterval = parseIntegerOption(value, -1);
+            if (options.snapshotInterval < 1) throw std::runtime_error("--snapshot-interval expects a positive number of time units");
+        } else if (arg == "--cfs-latency" || arg == "--cfs-granularity") {
+            int parsed = parseIntegerOption(value, 0);
+            if (arg == "--cfs-latency") options.cfsParameters.targetLatency = parsed;
+            else options.cfsParameters.minGranularity = parsed;
+            try {
+                options.cfsParameters.validate();
+            } catch (const std::runtime_error& e) {
+                throw std::runtime_error(arg + ": " + e.what());
+            }
+            options.cfsParametersSet = true;
+        } else if (arg == "--cpus" || arg == "--migration-cost") {
+            int parsed = parseIntegerOption(value, -1);
+            if (arg == "--cpus") options.multiCore.cores = parsed;
+            else options.multiCore.migrationCost = parsed;
+            try {
+                options.multiCore.validate();
+            } catch (const std::runtime_error& e) {
+                throw std::runtime_error(arg + ": " + e.what());
+            }
+            options.multiCoreSet = true;
+        } else if (arg == "--switch-cost" || arg == "--preemption-cost") {
+            int parsed = parseIntegerOption(value, -1);
+            if (parsed < 0) throw std::runtime_error(arg + " expects a non-negative number of time units");
+            if (arg == "--switch-cost") {
+                options.simulation.contextSwitch.voluntary = parsed;
+                if (!preemptionCostSet) options.simulation.contextSwitch.preemption = parsed;
+            } else {
+                options.simulation.contextSwitch.preemption = parsed;
+                preemptionCostSet = true;
+            }
+        } else if (arg == "--io-devices") {
+            options.simulation.ioDevices = parseIntegerOption(value, 0);
+            if (options.simulation.ioDevices < 1) throw std::runtime_error("--io-devices expects a positive device count");
+        } else if (arg == "--what-if") {
+            options.whatIfEdits.push_back(value);
+        } else if (arg == "--checkpoint-interval") {
+            options.checkpointInterval = parseIntegerOption(value, -1);
+            if (options.checkpointInterval < 1) throw std::runtime_error("--checkpoint-interval expects a positive number of time units");
+        } else if (arg == "--replicas") {
+            options.replicas = parseIntegerOption(value, 0);
+            if (options.replicas < 2) throw std::runtime_error("--replicas expects a count of at least 2");
+        } else if (arg == "--replica-model") {
+            if (value != "resample" && value != "fit") throw std::runtime_error("--replica-model expects resample or fit");
+            options.fitModel = (value == "fit");
+            options.replicaModelSet = true;
+        } else if (arg == "--trace") {
+            options.traceFile = value;
+        } else if (arg == "--trace-capacity") {
+            long long capacity = 0;
+            size_t consumed = 0;
+            try {
+                capacity = std::stoll(value, &consumed);
+            } catch (const std::exception& e) {
+                capacity = 0;
+            }
+            if (consumed != value.size()) capacity = 0;
+            if (capacity < 1) throw std::runtime_error("--trace-capacity expects a positive number of events");
+            options.traceCapacity = static_cast<size_t>(capacity);
+        } else if (arg == "--jobs") {
+            options.jobs = parseIntegerOption(value, -1);
+            if (options.jobs < 1) throw std::runtime_error("--jobs expects a positive thread count");
+        } else if (applyGeneratorOption(options.generatorConfig, arg.substr(2), value)) {
+            if (arg == "--seed") options.seedSet = true;
+            else options.generatorOptionUsed = true;
+        } else {
+            options.unexpected = arg;
+            break;
+        }
+    }
+    return options;
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--jobs N] [--stats] [--cpus N] [--migration-cost T] [--switch-cost T] [--preemption-cost T] [--io-devices N] [--trace FILE [--trace-capacity N]] [--mlfq-config FILE] [--cfs-latency T] [--cfs-granularity T] <process_file.txt | --generate [GENERATOR_OPTIONS]>" << std::endl;
+    std::cerr << "       " << program << " [--sweep] [--rr-quantum LIST] [--mlfq-q0 LIST] [--mlfq-q1 LIST] [--mlfq-aging LIST] [--jobs N] [--switch-cost T] [--preemption-cost T] [--io-devices N] <process_file.txt | --generate [GENERATOR_OPTIONS]>" << std::endl;
+    std::cerr << "       " << program << " --what-if ID:DELAY [--what-if ID:DELAY ...] [--checkpoint-interval T] [--jobs N] [--switch-cost T] [--preemption-cost T] [--io-devices N] [--mlfq-config FILE] [--cfs-latency T] [--cfs-granularity T] <process_file.txt | --generate [GENERATOR_OPTIONS]>" << std::endl;
+    std::cerr << "       " << program << " --replicas K [--replica-model resample|fit] [--seed S] [--jobs N] [--switch-cost T] [--preemption-cost T] [--io-devices N] [--mlfq-config FILE] [--cfs-latency T] [--cfs-granularity T] <process_file.txt | --generate [GENERATOR_OPTIONS]>" << std::endl;
+    std::cerr << "       " << program << " --stream ALGORITHM [--snapshot-interval T] [--stats] [--switch-cost T] [--preemption-cost T] [--io-devices N] [--trace FILE [--trace-capacity N]] [--rr-quantum N] [--mlfq-config FILE] [--cfs-latency T] [--cfs-granularity T] <process_file.txt | - | --generate [GENERATOR_OPTIONS]>" << std::endl;
+    std::cerr << "  --sweep or any LIST runs every Round Robin quantum and MLFQ combination; --mlfq-config and the CFS options do not apply to it" << std::endl;
+    std::cerr << "  LIST is a value, an inclusive range first:last[:step], or a comma-separated list of those" << std::endl;
+    std::cerr << "  ALGORITHM is fcfs, sjf, srtf, priority, priority-preemptive, rr, mlfq or cfs" << std::endl;
+    std::cerr << "  --cpus and --migration-cost select the multi-CPU comparison and cannot be combined with --sweep or --stream" << std::endl;
+    std::cerr << "  --switch-cost charges T time units per context switch; --preemption-cost overrides it after a preemption" << std::endl;
+    std::cerr << "  --io-devices sets how many I/O devices serve the I/O bursts of processes that have them (default 1)" << std::endl;
+    std::cerr << "  --trace writes a Chrome trace-event timeline of each run, keeping its last N events (default 1048576); not with --sweep" << std::endl;
+    std::cerr << "  --stats adds per-run engine counters (wall time, ticks, ready-queue work, allocations) in builds configured with -DSCHEDULER_STATS=ON" << std::endl;
+    std::cerr << "  --what-if compares each algorithm with process ID arriving DELAY units later, re-simulating from checkpoints taken every T units" << std::endl;
+    std::cerr << "  --replicas runs every algorithm on K workloads resampled from the file (or generated from a model fitted to it, or by the generator) and reports 95% confidence intervals" << std::endl;
+    std::cerr << "  GENERATOR_OPTIONS are the generate_workload options (--count, --seed, --arrivals, --bursts, --priorities, ...)" << std::endl;
+}
@@ -0,0 +1,73 @@
+#ifndef COMMAND_LINE_H
+#define COMMAND_LINE_H
+
+#include <vector>
+#include <string>
+#include "Scheduler.h"
+#include "SimulationEngine.h"
+#include "MlfqConfig.h"
+#include "ParameterSweep.h"
+#include "WorkloadGenerator.h"
+#include "TraceRecorder.h"
+
+/** What one invocation of the simulator does; the options select exactly one. */
+enum class RunMode {
+    Compare,  // Every algorithm once over the workload, on one CPU or, with --cpus, on several
+    Sweep,    // --sweep or a parameter list: every Round Robin quantum and MLFQ combination
+    Stream,   // --stream ALGORITHM: one algorithm over a workload read while it runs
+    WhatIf,   // --what-if ID:DELAY: every algorithm against copies of the workload with delayed arrivals
+    Replicas  // --replicas K: every algorithm over K random workloads, with confidence intervals
+};
+
+/**
+ * The simulator's command line. parseCommandLine fills it in and rejects malformed option values;
+ * validate() then checks that the options given fit together.
+ */
+struct CommandLineOptions {
+    std::string filename;              // Process file, or "-" for standard input with --stream
+    bool generate = false;             // The workload comes from the generator instead of a file
+    GeneratorConfig generatorConfig;
+    bool generatorOptionUsed = false;  // A generator option other than --seed was given
+    bool seedSet = false;              // --seed also seeds the replicas resampled from a file
+    int jobs = 0;                      // 0 runs sequentially without timing output
+    bool sweep = false;                // --sweep itself
+    bool roundRobinListSet = false;    // --rr-quantum: a sweep list, or the quantum of --stream rr
+    bool mlfqListSet = false;          // --mlfq-q0, --mlfq-q1 or --mlfq-aging
+    SweepConfig sweepConfig;
+    std::string streamAlgorithm;
+    int snapshotInterval = 0;          // 0 prints no interim snapshots
+    MultiCoreConfig multiCore;
+    bool multiCoreSet = false;         // --cpus or --migration-cost
+    SimulationOptions simulation;      // Switch costs and I/O devices; each run gets its own trace
+    MlfqConfig mlfqConfig;
+    bool mlfqConfigSet = false;        // --mlfq-config
+    CfsParameters cfsParameters;
+    bool cfsParametersSet = false;     // --cfs-latency or --cfs-granularity
+    std::string traceFile;
+    size_t traceCapacity = TraceRecorder::DEFAULT_CAPACITY;
+    std::vector<std::string> whatIfEdits;
+    int checkpointInterval = 0;        // 0 picks one from the arrival span
+    int replicas = 0;
+    bool fitModel = false;             // --replica-model fit
+    bool replicaModelSet = false;
+    bool showStats = false;
+    std::string unexpected;            // First argument that is neither a known option nor the input, if any
+
+    CommandLineOptions();
+
+    RunMode mode() const;
+
+    /** Throws runtime error naming the first rule the options break. */
+    void validate() const;
+};
+
+/**
+ * Reads the simulator options from argv. Throws runtime error for a malformed value or an unreadable MLFQ
+ * configuration; an unknown argument is kept in unexpected for validate() to report.
+ */
+CommandLineOptions parseCommandLine(int argc, char* argv[]);
+
+/** Prints the usage of every mode and what the options mean. */
+void printUsage(const char* program);
+
+#endif
@@ -0,0 +1,104 @@
+#include "EngineStats.h"
+
+#ifdef SCHEDULER_STATS
+
+#include "Scheduler.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+static thread_local EngineCounters counters = {};
+
+EngineCounters& engineCounters() {
+    return counters;
+}
+
+/**
+ * Replacements of the global allocation functions that count every allocation on the calling thread.
+ * The array and nothrow forms are routed through these; aligned allocations are not counted.
+ */
+void* operator new(std::size_t size) {
+    counters.allocations++;
+    counters.allocatedBytes += size;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return operator new(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+
+/** Ready depth restarts at zero: each run starts with empty ready queues. */
+EngineStatsScope::EngineStatsScope() : startTime(std::chrono::steady_clock::now()) {
+    counters.readyDepth = 0;
+    counters.peakReadyDepth = 0;
+    start = counters;
+}
+
+void EngineStatsScope::finish(SimulationResult& result) const {
+    EngineStats& stats = result.engineStats;
+    stats.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    stats.ticks = counters.ticks - start.ticks;
+    stats.readyQueueOps = counters.readyQueueOps - start.readyQueueOps;
+    stats.readyQueueScanned = counters.readyQueueScanned - start.readyQueueScanned;
+    stats.allocations = counters.allocations - start.allocations;
+    stats.allocatedBytes = counters.allocatedBytes - start.allocatedBytes;
+    stats.peakReadyDepth = counters.peakReadyDepth;
+}
+
+void printEngineStats(const std::vector<SimulationResult>& results) {
+    if (results.empty()) return;
+
+    size_t nameWidth = 45;
+    for (const auto& result : results) nameWidth = std::max(nameWidth, result.algorithmName.size() + 1);
+
+    std::cout << "\n--- Engine Statistics ---" << std::endl;
+    std::cout << std::left << std::setw(nameWidth) << "Algorithm"
+              << std::setw(12) << "Wall (s)"
+              << std::setw(12) << "Ticks"
+              << std::setw(14) << "Queue Ops"
+              << std::setw(11) << "Avg Scan"
+              << std::setw(13) << "Preemptions"
+              << std::setw(13) << "Allocations"
+              << std::setw(15) << "Allocated (B)"
+              << std::setw(12) << "Peak Ready"
+              << std::endl;
+    std::cout << std::string(nameWidth + 102, '-') << std::endl;
+    for (const auto& result : results) {
+        const EngineStats& stats = result.engineStats;
+        std::cout << std::left << std::setw(nameWidth) << result.algorithmName
+                  << std::fixed << std::setprecision(6) << std::setw(12) << stats.wallSeconds
+                  << std::setw(12) << stats.ticks
+                  << std::setw(14) << stats.readyQueueOps
+                  << std::setprecision(2) << std::setw(11) << stats.averageScanLength()
+                  << std::setw(13) << result.preemptions
+                  << std::setw(13) << stats.allocations
+                  << std::setw(15) << stats.allocatedBytes
+                  << std::setw(12) << stats.peakReadyDepth
+                  << std::endl;
+    }
+    std::cout << "----------------------------" << std::endl;
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef ENGINE_STATS_H
+#define ENGINE_STATS_H
+
+#include <vector>
+#include <chrono>
+
+struct SimulationResult;
+
+/**
+ * Engine self-instrumentation reported by --stats. It only exists in builds configured with -DSCHEDULER_STATS=ON;
+ * elsewhere every counting function below is an empty inline function and EngineStatsScope an empty class, so
+ * the engines and policies compile to the same code as without them.
+ * Counters are per thread: a run executes on one thread from start to end, so runs on a thread pool do not mix.
+ */
+
+#ifdef SCHEDULER_STATS
+
+/** Counters of one run, measured between the construction of its EngineStatsScope and finish(). */
+struct EngineStats {
+    double wallSeconds = 0;
+    long long ticks = 0;             // Simulated instants at which a CPU was rescheduled; the engines skip the time between them
+    long long readyQueueOps = 0;     // Insertions into and removals from the ready queues
+    long long readyQueueScanned = 0; // Entries, heap levels, bitmap words or queue levels those operations and lookups examined
+    long long allocations = 0;       // Calls to operator new, whoever made them on the run's thread
+    long long allocatedBytes = 0;
+    long long peakReadyDepth = 0;    // Most processes waiting in ready queues at once, over all CPUs
+
+    double averageScanLength() const { return readyQueueOps > 0 ? static_cast<double>(readyQueueScanned) / readyQueueOps : 0.0; }
+};
+
+/** Running totals of the calling thread. */
+struct EngineCounters {
+    long long ticks;
+    long long readyQueueOps;
+    long long readyQueueScanned;
+    long long allocations;
+    long long allocatedBytes;
+    long long readyDepth;
+    long long peakReadyDepth;
+};
+
+EngineCounters& engineCounters();
+
+/** A CPU was rescheduled. */
+inline void statsTick() { engineCounters().ticks++; }
+
+/** A process entered a ready queue; the operation touched one entry. */
+inline void statsReadyInsert() {
+    EngineCounters& counters = engineCounters();
+    counters.readyQueueOps++;
+    counters.readyQueueScanned++;
+    if (++counters.readyDepth > counters.peakReadyDepth) counters.peakReadyDepth = counters.readyDepth;
+}
+
+/** A process left a ready queue; the operation touched one entry. */
+inline void statsReadyRemove() {
+    EngineCounters& counters = engineCounters();
+    counters.readyQueueOps++;
+    counters.readyQueueScanned++;
+    counters.readyDepth--;
+}
+
+/** A ready-queue operation or lookup examined count further entries or levels. */
+inline void statsReadyScan(long long count) { engineCounters().readyQueueScanned += count; }
+
+/** Measures one run: construct it when the run starts, on the thread that executes the run. */
+class EngineStatsScope {
+public:
+    EngineStatsScope();
+
+    /** Stores the counters accumulated since construction in result.engineStats. */
+    void finish(SimulationResult& result) const;
+
+private:
+    EngineCounters start;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+/** Prints wall time, ticks, ready-queue work, preemptions, allocations and peak ready depth of each run. */
+void printEngineStats(const std::vector<SimulationResult>& results);
+
+#else
+
+inline void statsTick() {}
+inline void statsReadyInsert() {}
+inline void statsReadyRemove() {}
+inline void statsReadyScan(long long /*count*/) {}
+
+class EngineStatsScope {
+public:
+    void finish(SimulationResult& /*result*/) const {}
+};
+
+inline void printEngineStats(const std::vector<SimulationResult>& /*results*/) {}
+
+#endif
+
+#endif
@@ -0,0 +1,446 @@
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <memory>
+#include <algorithm>
+#include "Workload.h"
+#include "Scheduler.h"
+#include "EventQueue.h"
+#include "TraceRecorder.h"
+#include "SchedulingPolicy.h"
+
+/**
+ * Event loop of the single-CPU engines and the state it works on. It is a template over the arrival source and
+ * the policy type, so it lives in a header: SimulationEngine::run instantiates it for each concrete policy.
+ */
+
+/** Snapshot time used when interim snapshots are disabled (or past the last representable one). */
+static const int NO_SNAPSHOT = std::numeric_limits<int>::max();
+
+/** Checkpoint time used when a run keeps no checkpoints, and the first difference of two identical workloads. */
+static const int NO_CHECKPOINT = std::numeric_limits<int>::max();
+
+/** Part of [from, to) still taken by a context switch that ends at switchUntil. */
+inline int switchOverlap(int from, int to, int switchUntil) {
+    return std::max(0, std::min(to, switchUntil) - from);
+}
+
+/**
+ * Where a process is in its CPU/I-O burst sequence. Engines fill one per slot only for processes that do I/O.
+ * Time spent blocked counts as service, so waiting time stays the time spent ready but not running.
+ */
+struct IoProgress {
+    const int* sequence = nullptr; // The process's I/O, CPU, ... bursts
+    int next = 0;                  // Index of the next I/O burst (each is followed by a CPU burst)
+    int count = 0;
+    int cpuBurst = 0;              // Length of the CPU burst the process is on
+    int serviceTime = 0;           // Finished CPU bursts plus time blocked on I/O, queued or served
+    int blockedSince = 0;
+
+    IoProgress() {}
+    IoProgress(const int* bursts, int count, int firstBurst) : sequence(bursts), count(count), cpuBurst(firstBurst) {}
+
+    bool blocksAfterBurst() const { return next != count; }
+
+    /** Moves on to the next I/O burst when the current CPU burst ends at now; returns the I/O burst's length. */
+    int block(int now) {
+        int ioBurst = sequence[next];
+        serviceTime += cpuBurst;
+        cpuBurst = sequence[next + 1];
+        next += 2;
+        blockedSince = now;
+        return ioBurst;
+    }
+
+    /** Ends the I/O burst at now; returns the CPU burst the process runs next. */
+    int wake(int now) {
+        serviceTime += now - blockedSince;
+        return cpuBurst;
+    }
+
+    /** CPU and blocked time of a completed process, which OnlineMetrics subtracts from its turnaround time. */
+    int totalService() const { return serviceTime + cpuBurst; }
+};
+
+/** An I/O burst of the process in slot (on CPU core), as queued for and served by an IoDevices bank. */
+struct IoRequest {
+    int slot;
+    int core;
+    int length;
+    int submitted;
+    int device; // Set when a device starts serving it
+};
+
+/**
+ * Identical I/O devices serving blocked processes from one FIFO queue. A request starts on a free device at
+ * once, or when the device finishing the oldest earlier request becomes free; every start schedules an IoComplete
+ * event whose core field is the device. Busy time is booked when a request starts, which is exact once the run ends.
+ */
+class IoDevices {
+public:
+    explicit IoDevices(int count) : serving(count), requests(0), busyTime(0), waitTime(0) {
+        for (int device = count - 1; device >= 0; --device) idle.push_back(device);
+    }
+
+    void submit(const IoRequest& request, EventQueue& events) {
+        if (idle.empty()) {
+            enqueue(request);
+            return;
+        }
+        int device = idle.back();
+        idle.pop_back();
+        start(device, request, request.submitted, events);
+    }
+
+    /** Frees device at now, starting the longest-waiting request on it, and returns the request it finished. */
+    IoRequest finish(int device, int now, EventQueue& events) {
+        IoRequest done = serving[device];
+        if (waitingCount == 0) {
+            idle.push_back(device);
+        } else {
+            start(device, dequeue(), now, events);
+        }
+        return done;
+    }
+
+    /** Adds the request count, device utilization over elapsed time and queueing time to result. */
+    void fill(SimulationResult& result, int elapsed) const {
+        result.ioRequests = requests;
+        result.ioWaitTime = waitTime;
+        double capacity = static_cast<double>(elapsed) * serving.size();
+        result.ioUtilization = (capacity > 0) ? busyTime / capacity * 100.0 : 0.0;
+    }
+
+private:
+    /** Appends to the waiting ring, doubling it (oldest request first) only when it is full. */
+    void enqueue(const IoRequest& request) {
+        if (waitingCount == waiting.size()) {
+            std::vector<IoRequest> grown(std::max<size_t>(16, waiting.size() * 2));
+            for (size_t i = 0; i < waitingCount; ++i) grown[i] = waiting[(waitingHead + i) & (waiting.size() - 1)];
+            waiting.swap(grown);
+            waitingHead = 0;
+        }
+        waiting[(waitingHead + waitingCount) & (waiting.size() - 1)] = request;
+        waitingCount++;
+    }
+
+    IoRequest dequeue() {
+        IoRequest request = waiting[waitingHead];
+        waitingHead = (waitingHead + 1) & (waiting.size() - 1);
+        waitingCount--;
+        return request;
+    }
+
+    void start(int device, const IoRequest& request, int now, EventQueue& events) {
+        serving[device] = request;
+        serving[device].device = device;
+        requests++;
+        busyTime += request.length;
+        waitTime += now - request.submitted;
+        events.push(now + request.length, EventType::IoComplete, 0, device);
+    }
+
+    std::vector<IoRequest> serving; // Request on each busy device
+    std::vector<int> idle;          // Free devices, lowest index on top
+    std::vector<IoRequest> waiting; // Ring of requests waiting for a device, a power of two long
+    size_t waitingHead = 0;         // Oldest waiting request
+    size_t waitingCount = 0;
+    long long requests;
+    long long busyTime;
+    long long waitTime;
+};
+
+/**
+ * Arrival source over a shared in-memory workload; process i keeps slot i for the whole run.
+ * Only the ProcessState arena is allocated per run.
+ */
+class WorkloadArrivals {
+public:
+    explicit WorkloadArrivals(const Workload& workload) : processes(workload), nextIdx(0) {
+        runState.reserve(workload.size());
+        for (int burst : workload.burstTimes) runState.emplace_back(burst);
+    }
+
+    /** Resumes a run in which the first admittedStates.size() processes were admitted, with their run state. */
+    WorkloadArrivals(const Workload& workload, const std::vector<ProcessState>& admittedStates) : WorkloadArrivals(workload) {
+        std::copy(admittedStates.begin(), admittedStates.end(), runState.begin());
+        nextIdx = admittedStates.size();
+    }
+
+    bool exhausted() const { return nextIdx == processes.size(); }
+    int nextArrival() const { return processes.arrivalTimes[nextIdx]; }
+    int admitNext() { return static_cast<int>(nextIdx++); }
+    size_t admittedCount() const { return nextIdx; }
+    void release(int /*slot*/) {}
+    size_t slotCount() const { return processes.size(); }
+    int burstCount(int slot) const { return processes.burstCount(slot); }
+    const int* burstSequence(int slot) const { return processes.burstSequence(slot); }
+    const Workload& workload() const { return processes; }
+    std::vector<ProcessState>& states() { return runState; }
+
+private:
+    const Workload& processes;
+    std::vector<ProcessState> runState;
+    size_t nextIdx;
+};
+
+/**
+ * Complete state of runEventLoop between two instants: every event before time has been applied and none at or after it.
+ * Only the first admitted processes have entered the system, so the state holds for any workload that agrees with the
+ * checkpointed one on every process arriving before time. The queued Arrival event is replaced on resume, since it
+ * points at the next process of whichever workload the run continues with.
+ */
+struct SimulationCheckpoint {
+    int time;
+    size_t admitted;
+    std::vector<ProcessState> states; // Of slots [0, admitted)
+    std::vector<IoProgress> io;
+    std::unique_ptr<SchedulingPolicy> policy;
+    EventQueue events;
+    OnlineMetrics metrics;
+    IoDevices devices;
+    int currentTime;
+    int totalIdleTime;
+    size_t inFlight;
+    size_t reservedSlots;
+    long long eventCount;
+    long long contextSwitches;
+    long long preemptions;
+    long long totalSwitchTime;
+    int running;
+    int dispatchId;
+    int pendingTimer;
+    int switchUntil;
+};
+
+/**
+ * Runs the event loop for a single policy.
+ * Each iteration pops the earliest event, charges the elapsed time to the running process (or to idle time),
+ * and applies the event. Once every event at the current instant has been applied, the policy is asked which
+ * process should hold the CPU, and a Completion or SliceEnd event is scheduled for a newly dispatched process.
+ * Events belonging to an earlier dispatch are discarded as stale.
+ * Before the clock moves past a snapshot time, the metrics up to that time are passed to onSnapshot.
+ * Dispatching a process other than the previous one first costs a context switch (dearer after a preemption if
+ * configured): its Completion or SliceEnd is pushed back by the switch, which is charged neither to it nor to idle time.
+ * A process preempted before its switch finished has not started, so its start time is cleared again.
+ * A CPU burst followed by I/O ends in a block rather than a completion: the process waits for an I/O device while
+ * the CPU moves on, and the policy gets it back through wake() when its IoComplete event arrives.
+ * With a non-null trace, arrivals, completions and every change of the running process are recorded.
+ * The Checkpointed instantiation appends the whole loop state to checkpoints (if set) at the first instant at or after
+ * every multiple of checkpointInterval, or continues from resume (if set) instead of starting at time 0; arrivals must
+ * then already have admitted the checkpoint's processes and policy must be a copy of the checkpoint's policy. Plain runs
+ * use the other instantiation, which has none of this code in its loop.
+ * Policy is SchedulingPolicy or a class derived from it. The loop calls the policy through that static type, so for a
+ * final policy class every call is resolved at compile time and can be inlined; with SchedulingPolicy itself the
+ * calls stay virtual.
+ */
+template <typename Arrivals, typename Policy, bool Checkpointed = false>
+SimulationResult runEventLoop(Arrivals& arrivals, Policy& policy, const std::string& algorithmName,
+                              int snapshotInterval, const SnapshotCallback& onSnapshot, const SimulationOptions& options,
+                              const SimulationCheckpoint* resume = nullptr, std::vector<SimulationCheckpoint>* checkpoints = nullptr,
+                              int checkpointInterval = 0) {
+    EngineStatsScope statsScope;
+    SimulationResult result(algorithmName);
+    OnlineMetrics metrics;
+    EventQueue events;
+    int currentTime = Checkpointed && resume ? resume->currentTime : 0;
+    int totalIdleTime = Checkpointed && resume ? resume->totalIdleTime : 0;
+    size_t inFlight = Checkpointed && resume ? resume->inFlight : 0;
+    size_t reservedSlots = Checkpointed && resume ? resume->reservedSlots : 0;
+    long long eventCount = Checkpointed && resume ? resume->eventCount : 0;
+    long long contextSwitches = Checkpointed && resume ? resume->contextSwitches : 0;
+    long long preemptions = Checkpointed && resume ? resume->preemptions : 0;
+    long long totalSwitchTime = Checkpointed && resume ? resume->totalSwitchTime : 0;
+    int nextSnapshot = (snapshotInterval > 0 && onSnapshot) ? snapshotInterval : NO_SNAPSHOT;
+    TraceRecorder* trace = options.trace;
+
+    const Workload& workload = arrivals.workload();
+    std::vector<ProcessState>& states = arrivals.states();
+    policy.attach(workload, states, trace);
+
+    int running = Checkpointed && resume ? resume->running : SchedulingPolicy::NO_PROCESS;
+    int dispatchId = Checkpointed && resume ? resume->dispatchId : 0;
+    bool sliceExpired = false;
+    int pendingTimer = Checkpointed && resume ? resume->pendingTimer : SchedulingPolicy::NO_TIMER;
+    int switchUntil = Checkpointed && resume ? resume->switchUntil : 0; // End of the context switch into the running process
+    IoDevices devices(options.ioDevices);
+    std::vector<IoProgress> io; // By slot, for processes that do I/O
+    int nextCheckpoint = (Checkpointed && checkpoints != nullptr) ? checkpointInterval : NO_CHECKPOINT;
+
+    auto isStale = [&](const Event& e) {
+        return (e.type == EventType::Completion || e.type == EventType::SliceEnd) &&
+               (running == SchedulingPolicy::NO_PROCESS || e.dispatchId != dispatchId);
+    };
+
+    if (Checkpointed && resume != nullptr) {
+        events = resume->events;
+        events.removeAll(EventType::Arrival); // Queued again below for this workload's next process
+        metrics = resume->metrics;
+        devices = resume->devices;
+        io = resume->io;
+        for (size_t slot = 0; slot < resume->admitted; ++slot) {
+            if (arrivals.burstCount(slot) > 0) io[slot].sequence = arrivals.burstSequence(slot);
+        }
+    }
+
+    if (!arrivals.exhausted()) {
+        events.push(std::max(arrivals.nextArrival(), currentTime), EventType::Arrival);
+    }
+
+    while ((!arrivals.exhausted() || inFlight > 0) && !events.empty()) {
+        if (Checkpointed && events.top().time >= nextCheckpoint && checkpoints != nullptr) {
+            // Between two instants: the previous one is fully decided and nothing at the next one has happened yet
+            int time = events.top().time;
+            size_t admitted = arrivals.admittedCount();
+            checkpoints->push_back(SimulationCheckpoint{time, admitted, std::vector<ProcessState>(states.begin(), states.begin() + admitted),
+                                                        io, policy.copy(), events, metrics, devices, currentTime, totalIdleTime, inFlight,
+                                                        reservedSlots, eventCount, contextSwitches, preemptions, totalSwitchTime,
+                                                        running, dispatchId, pendingTimer, switchUntil});
+            nextCheckpoint = (time > NO_CHECKPOINT - checkpointInterval) ? NO_CHECKPOINT : (time / checkpointInterval + 1) * checkpointInterval;
+        }
+
+        Event event = events.top();
+        events.pop();
+        eventCount++;
+        if (isStale(event)) continue;
+
+        while (nextSnapshot < event.time) {
+            SimulationResult snapshot(algorithmName);
+            int idleTime = totalIdleTime + (running == SchedulingPolicy::NO_PROCESS ? nextSnapshot - currentTime : 0);
+            long long switchTime = totalSwitchTime + (running != SchedulingPolicy::NO_PROCESS ? switchOverlap(currentTime, nextSnapshot, switchUntil) : 0);
+            metrics.fill(snapshot, nextSnapshot, idleTime, switchTime);
+            onSnapshot(snapshot);
+            nextSnapshot = (nextSnapshot > NO_SNAPSHOT - snapshotInterval) ? NO_SNAPSHOT : nextSnapshot + snapshotInterval;
+        }
+
+        // Advance the clock, charging the elapsed time to the context switch, the running process or idle time
+        if (event.time > currentTime) {
+            if (running != SchedulingPolicy::NO_PROCESS) {
+                int switching = switchOverlap(currentTime, event.time, switchUntil);
+                totalSwitchTime += switching;
+                states[running].remainingBurstTime -= event.time - currentTime - switching;
+            } else {
+                totalIdleTime += event.time - currentTime;
+            }
+            currentTime = event.time;
+        }
+
+        switch (event.type) {
+            case EventType::Arrival:
+                while (!arrivals.exhausted() && arrivals.nextArrival() <= currentTime) {
+                    int slot = arrivals.admitNext();
+                    if (arrivals.slotCount() > reservedSlots) {
+                        reservedSlots = std::max(arrivals.slotCount(), reservedSlots * 2);
+                        policy.reserveSlots(reservedSlots);
+                    }
+                    int bursts = arrivals.burstCount(slot);
+                    if (bursts > 0) {
+                        if (io.size() <= static_cast<size_t>(slot)) io.resize(std::max(reservedSlots, static_cast<size_t>(slot) + 1));
+                        io[slot] = IoProgress(arrivals.burstSequence(slot), bursts, workload.burstTimes[slot]);
+                    }
+                    if (trace) trace->record(TraceEventType::Arrival, currentTime, workload.ids[slot], 0, 0);
+                    policy.admit(slot, currentTime);
+                    inFlight++;
+                }
+                if (!arrivals.exhausted()) {
+                    events.push(arrivals.nextArrival(), EventType::Arrival);
+                }
+                break;
+            case EventType::Completion: {
+                states[running].remainingBurstTime = 0;
+                bool doesIo = arrivals.burstCount(running) > 0;
+                if (doesIo && io[running].blocksAfterBurst()) {
+                    int ioBurst = io[running].block(currentTime);
+                    if (trace) trace->record(TraceEventType::Block, currentTime, workload.ids[running], 0, ioBurst);
+                    devices.submit(IoRequest{running, 0, ioBurst, currentTime, -1}, events);
+                    running = SchedulingPolicy::NO_PROCESS; // CPU becomes free while the process waits
+                    break;
+                }
+                states[running].completionTime = currentTime;
+                if (trace) trace->record(TraceEventType::Completion, currentTime, workload.ids[running], 0, 0);
+                metrics.record(workload.arrivalTimes[running], doesIo ? io[running].totalService() : workload.burstTimes[running], states[running]);
+                arrivals.release(running);
+                inFlight--;
+                running = SchedulingPolicy::NO_PROCESS; // CPU becomes free
+                break;
+            }
+            case EventType::SliceEnd:
+                sliceExpired = true;
+                break;
+            case EventType::Timer:
+                if (event.time == pendingTimer) pendingTimer = SchedulingPolicy::NO_TIMER;
+                break;
+            case EventType::IoComplete: {
+                IoRequest done = devices.finish(event.core, currentTime, events);
+                states[done.slot].remainingBurstTime = io[done.slot].wake(currentTime);
+                if (trace) trace->record(TraceEventType::Wakeup, currentTime, workload.ids[done.slot], 0, event.core);
+                policy.wake(done.slot, currentTime);
+                break;
+            }
+        }
+
+        // Only make a scheduling decision once every event at this instant has been applied
+        while (!events.empty() && isStale(events.top())) {
+            events.pop();
+            eventCount++;
+        }
+        if (!events.empty() && events.top().time == currentTime) continue;
+
+        statsTick();
+        int next = policy.schedule(running, currentTime, sliceExpired);
+        if (next != running || sliceExpired) {
+            bool switched = (next != running);
+            bool preempted = switched && running != SchedulingPolicy::NO_PROCESS;
+            if (preempted) {
+                preemptions++;
+                ProcessState& state = states[running];
+                if (state.startTime > currentTime) state.startTime = state.responseTime = -1; // Its switch never finished
+                if (trace) trace->record(TraceEventType::Preemption, currentTime, workload.ids[running], 0, state.remainingBurstTime);
+            }
+            running = next;
+            if (running != SchedulingPolicy::NO_PROCESS) {
+                ProcessState& state = states[running];
+                dispatchId++;
+                int switchCost = 0;
+                if (switched) {
+                    contextSwitches++;
+                    switchCost = preempted ? options.contextSwitch.preemption : options.contextSwitch.voluntary;
+                }
+                switchUntil = currentTime + switchCost;
+                if (state.startTime == -1) {
+                    state.startTime = switchUntil;
+                    state.responseTime = state.startTime - workload.arrivalTimes[running];
+                }
+                int slice = policy.sliceLength(running);
+                if (trace && switched) {
+                    trace->record(TraceEventType::Dispatch, switchUntil, workload.ids[running], 0, slice == SchedulingPolicy::UNBOUNDED_SLICE ? -1 : slice);
+                }
+                if (state.remainingBurstTime <= slice) {
+                    events.push(switchUntil + state.remainingBurstTime, EventType::Completion, dispatchId);
+                } else {
+                    events.push(switchUntil + slice, EventType::SliceEnd, dispatchId);
+                }
+            }
+        }
+        sliceExpired = false;
+
+        int timer = policy.nextTimerTime();
+        if (timer > currentTime && timer < pendingTimer) {
+            events.push(timer, EventType::Timer);
+            pendingTimer = timer;
+        }
+    }
+
+    metrics.fill(result, currentTime, totalIdleTime, totalSwitchTime);
+    devices.fill(result, currentTime);
+    result.eventCount = eventCount;
+    result.contextSwitches = contextSwitches;
+    result.preemptions = preemptions;
+    statsScope.finish(result);
+    return result;
+}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <queue>
+#include <vector>
+
+/**
+ * Kinds of events understood by the simulation engine.
+ * When several events share a timestamp they are applied in this enum's order,
+ * which mirrors the order the original tick-by-tick loops observed them in.
+ */
+enum class EventType {
+    Arrival = 0,    // The next process (or batch of processes) in arrival order becomes ready
+    Completion = 1, // The running process finishes its burst
+    SliceEnd = 2,   // The running process exhausts its slice (quantum expiry or forced reschedule)
+    Timer = 3,      // A policy-requested wake-up, e.g. an MLFQ aging deadline
+    IoComplete = 4  // An I/O device finishes a burst and its process becomes ready again
+};
+
+/** A single timestamped simulation event. */
+struct Event {
+    int time;
+    EventType type;
+    long long sequence;  // Insertion order, used as the final tie-breaker
+    int dispatchId;      // Dispatch a Completion/SliceEnd belongs to; stale events are skipped
+    int core;            // CPU a Completion/SliceEnd/Timer belongs to (always 0 on a single CPU); device of an IoComplete
+
+    Event(int t, EventType ty, long long seq, int dispatch, int cpu)
+        : time(t), type(ty), sequence(seq), dispatchId(dispatch), core(cpu) {}
+};
+
+/**
+ * Time-ordered min-heap of simulation events.
+ * Events are ordered by time, then type, then insertion order, so the pop order is fully deterministic.
+ */
+class EventQueue {
+public:
+    void push(int time, EventType type, int dispatchId = 0, int core = 0) {
+        heap.emplace(time, type, nextSequence++, dispatchId, core);
+    }
+
+    bool empty() const { return heap.empty(); }
+    const Event& top() const { return heap.top(); }
+    void pop() { heap.pop(); }
+    size_t size() const { return heap.size(); }
+
+    /** Drops every queued event of the given type in O(n log n); the order of the remaining events is unchanged. */
+    void removeAll(EventType type) {
+        std::priority_queue<Event, std::vector<Event>, Later> kept;
+        for (; !heap.empty(); heap.pop()) {
+            if (heap.top().type != type) kept.push(heap.top());
+        }
+        heap.swap(kept);
+    }
+
+private:
+    struct Later {
+        bool operator()(const Event& a, const Event& b) const {
+            if (a.time != b.time) return a.time > b.time;
+            if (a.type != b.type) return a.type > b.type;
+            return a.sequence > b.sequence;
+        }
+    };
+
+    std::priority_queue<Event, std::vector<Event>, Later> heap;
+    long long nextSequence = 0;
+};
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <vector>
+#include <cstddef>
+#include "EngineStats.h"
+
+/**
+ * Ordering key used by the SJF and SRTF ready queues.
+ * primary is the burst (SJF) or remaining burst (SRTF); ties fall back to arrival time and then to the
+ * order in which the process was (re)inserted, matching the first-in-list tie-breaking of a std::list scan.
+ */
+struct ReadyKey {
+    int primary;
+    int arrivalTime;
+    long long sequence;
+
+    bool operator<(const ReadyKey& other) const {
+        if (primary != other.primary) return primary < other.primary;
+        if (arrivalTime != other.arrivalTime) return arrivalTime < other.arrivalTime;
+        return sequence < other.sequence;
+    }
+};
+
+/**
+ * Binary min-heap addressed by integer handles (process slots) in [0, capacity).
+ * A position table maps each handle to its heap index, so besides push/pop it supports
+ * O(log n) decrease-key and erase of an arbitrary element by handle.
+ */
+template <typename Key>
+class IndexedMinHeap {
+public:
+    explicit IndexedMinHeap(size_t capacity = 0) : keys(capacity), position(capacity, -1) {
+        heap.reserve(capacity);
+    }
+
+    /** Grows the handle range to [0, capacity); existing handles and their positions are kept. */
+    void reserve(size_t capacity) {
+        if (capacity <= position.size()) return;
+        keys.resize(capacity);
+        position.resize(capacity, -1);
+        heap.reserve(capacity);
+    }
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    bool contains(int handle) const { return position[handle] != -1; }
+
+    /** Handle of the minimum element; the heap must not be empty. */
+    int top() const { return heap.front(); }
+    const Key& topKey() const { return keys[heap.front()]; }
+    const Key& key(int handle) const { return keys[handle]; }
+
+    void push(int handle, const Key& key) {
+        keys[handle] = key;
+        position[handle] = static_cast<int>(heap.size());
+        heap.push_back(handle);
+        siftUp(position[handle]);
+    }
+
+    /** Removes and returns the handle of the minimum element. */
+    int pop() {
+        int handle = heap.front();
+        removeAt(0);
+        return handle;
+    }
+
+    /** Lowers the key of an element already in the heap. */
+    void decreaseKey(int handle, const Key& key) {
+        keys[handle] = key;
+        siftUp(position[handle]);
+    }
+
+    /** Removes an element by handle, wherever it sits in the heap. */
+    void erase(int handle) {
+        removeAt(position[handle]);
+    }
+
+private:
+    void removeAt(int index) {
+        int removed = heap[index];
+        int last = heap.back();
+        heap.pop_back();
+        position[removed] = -1;
+        if (index < static_cast<int>(heap.size())) {
+            heap[index] = last;
+            position[last] = index;
+            siftDown(index);
+            siftUp(position[last]);
+        }
+    }
+
+    void siftUp(int index) {
+        int handle = heap[index];
+        while (index > 0) {
+            int parent = (index - 1) / 2;
+            statsReadyScan(1);
+            if (!(keys[handle] < keys[heap[parent]])) break;
+            heap[index] = heap[parent];
+            position[heap[index]] = index;
+            index = parent;
+        }
+        heap[index] = handle;
+        position[handle] = index;
+    }
+
+    void siftDown(int index) {
+        int handle = heap[index];
+        int count = static_cast<int>(heap.size());
+        while (true) {
+            int child = 2 * index + 1;
+            if (child >= count) break;
+            if (child + 1 < count && keys[heap[child + 1]] < keys[heap[child]]) child++;
+            statsReadyScan(1);
+            if (!(keys[heap[child]] < keys[handle])) break;
+            heap[index] = heap[child];
+            position[heap[index]] = index;
+            index = child;
+        }
+        heap[index] = handle;
+        position[handle] = index;
+    }
+
+    std::vector<Key> keys;
+    std::vector<int> position;  // Heap index of each handle, -1 when absent
+    std::vector<int> heap;
+};
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+/** Tail summary of one latency distribution (in simulation time units). */
+struct LatencyPercentiles {
+    int p50 = 0;
+    int p90 = 0;
+    int p99 = 0;
+    int p999 = 0;
+    int max = 0;
+};
+
+/**
+ * HDR-style log-linear histogram of non-negative integer latencies.
+ * Values below 2^SUB_BUCKET_BITS get a bucket each and are exact; above that every power-of-two range is split
+ * into 2^SUB_BUCKET_BITS equal buckets, so a reported percentile is at most 1/1024 (about 0.1%) above the true
+ * value. Recording is O(1) and the bucket array only grows up to the largest value seen, so typical runs use a
+ * few KiB regardless of the number of processes. The maximum is tracked exactly.
+ */
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 10;
+
+    LatencyHistogram() : total(0), largest(0) {}
+
+    /** Records one latency; negative values are counted as 0. */
+    void record(int value) {
+        if (value < 0) value = 0;
+        size_t index = bucketIndex(static_cast<uint32_t>(value));
+        if (index >= counts.size()) counts.resize(std::max(index + 1, counts.size() * 2), 0);
+        counts[index]++;
+        total++;
+        largest = std::max(largest, value);
+    }
+
+    uint64_t count() const { return total; }
+
+    /**
+     * Nearest-rank percentiles: the first bucket whose cumulative count reaches ceil(q * count),
+     * reported as the largest value that bucket can hold (clamped to the exact maximum). All zero when empty.
+     */
+    LatencyPercentiles percentiles() const {
+        LatencyPercentiles result;
+        if (total == 0) return result;
+
+        const uint64_t perMille[4] = {500, 900, 990, 999};
+        int* outputs[4] = {&result.p50, &result.p90, &result.p99, &result.p999};
+        int next = 0;
+        uint64_t cumulative = 0;
+        for (size_t index = 0; index < counts.size() && next < 4; ++index) {
+            cumulative += counts[index];
+            while (next < 4 && cumulative >= rank(perMille[next])) {
+                *outputs[next++] = std::min(highestEquivalentValue(index), largest);
+            }
+        }
+        result.max = largest;
+        return result;
+    }
+
+private:
+    static const uint32_t SUB_BUCKET_COUNT = 1u << SUB_BUCKET_BITS;
+
+    /** Values below SUB_BUCKET_COUNT map to themselves; larger ones to (range + 1) * SUB_BUCKET_COUNT + sub-bucket. */
+    static size_t bucketIndex(uint32_t value) {
+        if (value < SUB_BUCKET_COUNT) return value;
+        int shift = (31 - __builtin_clz(value)) - SUB_BUCKET_BITS;
+        return (static_cast<size_t>(shift) + 1) * SUB_BUCKET_COUNT + ((value >> shift) - SUB_BUCKET_COUNT);
+    }
+
+    static int highestEquivalentValue(size_t index) {
+        if (index < SUB_BUCKET_COUNT) return static_cast<int>(index);
+        int shift = static_cast<int>(index / SUB_BUCKET_COUNT) - 1;
+        uint64_t low = (static_cast<uint64_t>(index % SUB_BUCKET_COUNT) + SUB_BUCKET_COUNT) << shift;
+        return static_cast<int>(std::min<uint64_t>(low + (uint64_t(1) << shift) - 1, INT32_MAX));
+    }
+
+    /** ceil(perMille / 1000 * count) in integer arithmetic, so p99 of 100 values is exactly rank 99. */
+    uint64_t rank(uint64_t perMille) const {
+        return std::max<uint64_t>((perMille * total + 999) / 1000, 1);
+    }
+
+    std::vector<uint64_t> counts;
+    uint64_t total;
+    int largest;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#include "MappedFile.h"
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& filename) : begin(nullptr), length(0), mapping(nullptr) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Error opening file: " + filename);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void* address = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            ::madvise(address, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+            mapping = address;
+            begin = static_cast<const char*>(address);
+            length = static_cast<size_t>(info.st_size);
+            ::close(fd);
+            return;
+        }
+    }
+
+    // Not mappable: read everything into the fallback buffer
+    char chunk[1 << 16];
+    ssize_t count;
+    while ((count = ::read(fd, chunk, sizeof(chunk))) > 0) {
+        buffer.insert(buffer.end(), chunk, chunk + count);
+    }
+    ::close(fd);
+    if (count < 0) {
+        throw std::runtime_error("Error reading file: " + filename);
+    }
+    begin = buffer.data();
+    length = buffer.size();
+}
+
+MappedFile::~MappedFile() {
+    if (mapping != nullptr) {
+        ::munmap(mapping, length);
+    }
+}
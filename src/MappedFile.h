@@ -0,0 +1,32 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/**
+ * Read-only view of a whole file.
+ * Regular files are memory-mapped so they can be scanned without copying; anything that cannot be mapped
+ * (pipes, empty files, special files) is read into an owned buffer instead. Throws runtime error if the file
+ * cannot be opened.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return begin; }
+    size_t size() const { return length; }
+
+private:
+    const char* begin;
+    size_t length;
+    void* mapping;
+    std::vector<char> buffer; // Fallback storage when the file cannot be mapped
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "MlfqConfig.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+MlfqConfig MlfqConfig::fromParameters(const MlfqParameters& parameters) {
+    MlfqConfig config;
+    config.levels.push_back(MlfqLevel(LevelPolicy::RoundRobin, parameters.quantumQ0));
+    config.levels.push_back(MlfqLevel(LevelPolicy::RoundRobin, parameters.quantumQ1));
+    config.levels.push_back(MlfqLevel(LevelPolicy::FCFS));
+    config.agingThreshold = parameters.agingThreshold;
+    config.boostRule = BoostRule::ToTop;
+    return config;
+}
+
+void MlfqConfig::validate() const {
+    if (levels.empty() || levels.size() > static_cast<size_t>(MAX_LEVELS)) {
+        throw std::runtime_error("MLFQ needs between 1 and " + std::to_string(MAX_LEVELS) + " levels, got " + std::to_string(levels.size()));
+    }
+    for (size_t i = 0; i < levels.size(); ++i) {
+        if (levels[i].policy == LevelPolicy::RoundRobin && levels[i].quantum <= 0) {
+            throw std::runtime_error("MLFQ level Q" + std::to_string(i) + " needs a positive quantum");
+        }
+    }
+    if (boostRule != BoostRule::None && agingThreshold <= 0) {
+        throw std::runtime_error("MLFQ aging threshold must be positive when boosting is enabled");
+    }
+}
+
+std::string MlfqConfig::describe() const {
+    std::string name = "MLFQ (";
+    for (size_t i = 0; i < levels.size(); ++i) {
+        name += "Q" + std::to_string(i) + ":";
+        name += (levels[i].policy == LevelPolicy::FCFS) ? "FCFS" : "RR" + std::to_string(levels[i].quantum);
+        name += ", ";
+    }
+    name += (boostRule == BoostRule::None) ? "Age:off" : "Age:" + std::to_string(agingThreshold);
+    if (boostRule == BoostRule::OneLevel) name += ", Boost:up";
+    return name + ")";
+}
+
+/** Trims surrounding whitespace the same way the process file loader does. */
+static std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\n\r");
+    if (first == std::string::npos) return "";
+    size_t last = text.find_last_not_of(" \t\n\r");
+    return text.substr(first, last - first + 1);
+}
+
+MlfqConfig loadMlfqConfigFromFile(const std::string& filename) {
+    std::ifstream infile(filename);
+    if (!infile) {
+        throw std::runtime_error("Error opening file: " + filename);
+    }
+
+    MlfqConfig config;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(infile, line)) {
+        lineNumber++;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        size_t separator = line.find('=');
+        if (separator == std::string::npos) {
+            throw std::runtime_error("Expected key = value on line " + std::to_string(lineNumber) + ": " + line);
+        }
+        std::string key = trim(line.substr(0, separator));
+        std::stringstream value(trim(line.substr(separator + 1)));
+
+        if (key == "level") {
+            std::string policy;
+            value >> policy;
+            if (policy == "FCFS") {
+                config.levels.push_back(MlfqLevel(LevelPolicy::FCFS));
+            } else if (policy == "RR") {
+                int quantum = 0;
+                if (!(value >> quantum)) {
+                    throw std::runtime_error("RR level needs a quantum on line " + std::to_string(lineNumber) + ": " + line);
+                }
+                config.levels.push_back(MlfqLevel(LevelPolicy::RoundRobin, quantum));
+            } else {
+                throw std::runtime_error("Unknown level policy on line " + std::to_string(lineNumber) + ": " + line);
+            }
+        } else if (key == "aging") {
+            if (!(value >> config.agingThreshold) || config.agingThreshold < 0) {
+                throw std::runtime_error("Invalid aging threshold on line " + std::to_string(lineNumber) + ": " + line);
+            }
+        } else if (key == "boost") {
+            std::string rule;
+            value >> rule;
+            if (rule == "top") config.boostRule = BoostRule::ToTop;
+            else if (rule == "up") config.boostRule = BoostRule::OneLevel;
+            else if (rule == "none") config.boostRule = BoostRule::None;
+            else throw std::runtime_error("Unknown boost rule on line " + std::to_string(lineNumber) + ": " + line);
+        } else {
+            throw std::runtime_error("Unknown key on line " + std::to_string(lineNumber) + ": " + line);
+        }
+    }
+
+    if (config.agingThreshold == 0) config.boostRule = BoostRule::None;
+    config.validate();
+    return config;
+}
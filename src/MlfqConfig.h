@@ -0,0 +1,76 @@
+#ifndef MLFQ_CONFIG_H
+#define MLFQ_CONFIG_H
+
+#include <vector>
+#include <string>
+
+/** Tunable parameters of the default 3-level MLFQ (Q0: RR, Q1: RR, Q2: FCFS). */
+struct MlfqParameters {
+    int quantumQ0;
+    int quantumQ1;
+    int agingThreshold;
+
+    MlfqParameters(int q0 = 8, int q1 = 16, int aging = 50) :
+        quantumQ0(q0),
+        quantumQ1(q1),
+        agingThreshold(aging) {}
+};
+
+/** Scheduling discipline used inside a single MLFQ level. */
+enum class LevelPolicy {
+    RoundRobin, // Runs for the level quantum, then is demoted one level
+    FCFS        // Runs until completion or preemption by a higher-level arrival
+};
+
+/** Where a queued process moves once it has waited agingThreshold time units. */
+enum class BoostRule {
+    None,     // Aging disabled
+    ToTop,    // Boost straight back to Q0
+    OneLevel  // Promote one level up
+};
+
+/** Configuration of one MLFQ level. */
+struct MlfqLevel {
+    LevelPolicy policy;
+    int quantum; // Ignored for FCFS levels
+
+    MlfqLevel(LevelPolicy levelPolicy = LevelPolicy::RoundRobin, int levelQuantum = 0) :
+        policy(levelPolicy),
+        quantum(levelQuantum) {}
+};
+
+/**
+ * Runtime description of a Multi-Level Feedback Queue: 1 to MAX_LEVELS levels (Q0 highest), each RR or FCFS,
+ * plus the aging rule applied to every level below Q0. New arrivals always enter Q0 and preempt a process
+ * running in a lower level.
+ */
+struct MlfqConfig {
+    static const int MAX_LEVELS = 8;
+
+    std::vector<MlfqLevel> levels;
+    int agingThreshold;
+    BoostRule boostRule;
+
+    MlfqConfig() : agingThreshold(50), boostRule(BoostRule::ToTop) {}
+
+    /** Builds the classic 3-level configuration (Q0: RR, Q1: RR, Q2: FCFS, boost to Q0). */
+    static MlfqConfig fromParameters(const MlfqParameters& parameters);
+
+    /** Throws runtime error if the level count, a quantum or the aging threshold is invalid. */
+    void validate() const;
+
+    /** Algorithm name used in the comparison table, e.g. "MLFQ (Q0:RR8, Q1:RR16, Q2:FCFS, Age:50)". */
+    std::string describe() const;
+};
+
+/**
+ * Loads an MLFQ configuration file.
+ * Each non-empty line not starting with '#' is "key = value", where key is one of:
+ *   level = RR <quantum> | FCFS   (repeat once per level, highest level first)
+ *   aging = <time units>          (0 disables aging)
+ *   boost = top | up | none
+ * Throws runtime error if the file cannot be opened or a line is malformed.
+ */
+MlfqConfig loadMlfqConfigFromFile(const std::string& filename);
+
+#endif
@@ -0,0 +1,131 @@
+#include "ParameterSweep.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <future>
+#include <functional>
+
+/** Converts one sweep value, rejecting anything that is not a positive integer. */
+static int parsePositive(const std::string& text, const std::string& spec) {
+    size_t consumed = 0;
+    int value = 0;
+    try {
+        value = std::stoi(text, &consumed);
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Invalid parameter list: " + spec);
+    }
+    if (consumed != text.size() || value <= 0) {
+        throw std::runtime_error("Parameter values must be positive integers: " + spec);
+    }
+    return value;
+}
+
+int parseIntegerOption(const std::string& text, int invalid) {
+    size_t consumed = 0;
+    int value = 0;
+    try {
+        value = std::stoi(text, &consumed);
+    } catch (const std::exception& e) {
+        return invalid;
+    }
+    return consumed == text.size() ? value : invalid;
+}
+
+std::vector<int> parseParameterList(const std::string& spec) {
+    std::vector<int> values;
+    std::stringstream items(spec);
+    std::string item;
+
+    while (std::getline(items, item, ',')) {
+        std::stringstream parts(item);
+        std::string part;
+        std::vector<int> bounds;
+        while (std::getline(parts, part, ':')) {
+            bounds.push_back(parsePositive(part, spec));
+        }
+
+        if (bounds.size() == 1) {
+            values.push_back(bounds[0]);
+        } else if (bounds.size() == 2 || bounds.size() == 3) {
+            int step = (bounds.size() == 3) ? bounds[2] : 1;
+            if (bounds[0] > bounds[1]) throw std::runtime_error("Range start exceeds end: " + spec);
+            for (int value = bounds[0]; value <= bounds[1]; value += step) {
+                values.push_back(value);
+                if (value > bounds[1] - step) break; // Avoid overflow past the end of the range
+            }
+        } else {
+            throw std::runtime_error("Invalid parameter list: " + spec);
+        }
+    }
+
+    if (values.empty()) throw std::runtime_error("Empty parameter list: " + spec);
+    return values;
+}
+
+std::vector<SimulationResult> runParameterSweep(const Workload& shared, const SweepConfig& config, ThreadPool& pool) {
+    std::vector<std::future<SimulationResult>> pending;
+    SimulationOptions options;
+    options.contextSwitch = config.contextSwitch;
+    options.ioDevices = config.ioDevices;
+    for (int quantum : config.roundRobinQuanta) {
+        pending.push_back(pool.submit([&shared, quantum, options] { return runRoundRobin(shared, quantum, options); }));
+    }
+    for (int q0 : config.mlfqQuantumQ0) {
+        for (int q1 : config.mlfqQuantumQ1) {
+            for (int aging : config.mlfqAgingThreshold) {
+                MlfqParameters parameters(q0, q1, aging);
+                pending.push_back(pool.submit([&shared, parameters, options] { return runMLFQ(shared, parameters, options); }));
+            }
+        }
+    }
+
+    std::vector<SimulationResult> results;
+    results.reserve(pending.size());
+    for (auto& future : pending) {
+        results.push_back(future.get());
+    }
+    return results;
+}
+
+std::vector<SimulationResult> paretoFrontier(const std::vector<SimulationResult>& results) {
+    std::vector<SimulationResult> sorted = results;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const SimulationResult& a, const SimulationResult& b) {
+        if (a.averageResponseTime != b.averageResponseTime) return a.averageResponseTime < b.averageResponseTime;
+        return a.averageTurnaroundTime < b.averageTurnaroundTime;
+    });
+
+    // After sorting by response time, a point is on the frontier iff it strictly improves the best turnaround so far
+    std::vector<SimulationResult> frontier;
+    for (const SimulationResult& result : sorted) {
+        if (frontier.empty() || result.averageTurnaroundTime < frontier.back().averageTurnaroundTime) {
+            frontier.push_back(result);
+        }
+    }
+    return frontier;
+}
+
+void printSweepResults(const std::vector<SimulationResult>& results) {
+    if (results.empty()) return;
+
+    printComparison(results);
+
+    std::vector<SimulationResult> frontier = paretoFrontier(results);
+    std::cout << "\n--- Pareto Frontier (Avg Response vs Avg Turnaround, " << frontier.size() << " of "
+              << results.size() << " configurations) ---" << std::endl;
+    std::cout << std::left << std::setw(45) << "Algorithm"
+              << std::setw(15) << "Avg Response"
+              << std::setw(15) << "Avg Turnaround"
+              << std::endl;
+    std::cout << std::string(75, '-') << std::endl;
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& result : frontier) {
+        std::cout << std::left << std::setw(45) << result.algorithmName
+                  << std::setw(15) << result.averageResponseTime
+                  << std::setw(15) << result.averageTurnaroundTime
+                  << std::endl;
+    }
+    std::cout << "----------------------------" << std::endl;
+}
@@ -0,0 +1,45 @@
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include <vector>
+#include <string>
+#include "Process.h"
+#include "Scheduler.h"
+#include "ThreadPool.h"
+
+/**
+ * Parameter grid explored by a sweep.
+ * Each Round Robin quantum is run once, and every combination of the three MLFQ lists is run once.
+ */
+struct SweepConfig {
+    std::vector<int> roundRobinQuanta;
+    std::vector<int> mlfqQuantumQ0;
+    std::vector<int> mlfqQuantumQ1;
+    std::vector<int> mlfqAgingThreshold;
+    ContextSwitchCost contextSwitch; // Applied to every run of the sweep
+    int ioDevices = 1;               // Likewise
+};
+
+/**
+ * Parses a parameter list such as "4", "2:16" (inclusive range), "2:16:2" (range with step) or "4,8,12",
+ * where comma-separated items may themselves be ranges. Throws runtime error on malformed or non-positive values.
+ */
+std::vector<int> parseParameterList(const std::string& spec);
+
+/** An option value as an integer, or invalid unless the whole of text is one (so "4x" and "2.5" are invalid). */
+int parseIntegerOption(const std::string& text, int invalid);
+
+/**
+ * Runs every configuration of the sweep as an independent task on the pool.
+ * All tasks share the workload read-only and only allocate their own run state. Results come back in a fixed order:
+ * the RR quanta first, then the MLFQ grid with the aging threshold varying fastest.
+ */
+std::vector<SimulationResult> runParameterSweep(const Workload& workload, const SweepConfig& config, ThreadPool& pool);
+
+/** Returns the results not dominated in (average response time, average turnaround time), ordered by response time. */
+std::vector<SimulationResult> paretoFrontier(const std::vector<SimulationResult>& results);
+
+/** Prints the full sweep comparison table followed by its Pareto frontier. */
+void printSweepResults(const std::vector<SimulationResult>& results);
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef PRIORITY_ARRAY_H
+#define PRIORITY_ARRAY_H
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdint>
+#include "EngineStats.h"
+
+/**
+ * O(1)-style priority array used as the Priority scheduling ready queue (lower number means higher priority).
+ * Priorities in [0, NUM_LEVELS) each get their own level plus a bit in an occupancy bitmap, so the highest
+ * non-empty level is found with a find-first-set instruction. Priorities outside that range fall back to a
+ * sparse std::map of levels, with a sorted list of the non-empty ones.
+ *
+ * Within a level processes are ordered by arrival time and then insertion order. Each level is a FIFO linked
+ * through a per-slot array, so fresh arrivals, which come in that order, are appended and popped in O(1).
+ * A push that would break the order (a preempted process requeued behind later arrivals, a process back from
+ * I/O or migrated from another CPU with an earlier arrival time) goes to a small per-level heap instead, and
+ * pop takes the earlier of the FIFO front and the heap top.
+ */
+class PriorityArray {
+public:
+    static const int NUM_LEVELS = 128;
+    static constexpr int NONE = -1;
+
+    PriorityArray() : levels(NUM_LEVELS), count(0), nextSequence(0) {
+        std::fill(bitmap, bitmap + BITMAP_WORDS, 0);
+    }
+
+    /**
+     * Makes room for slots [0, count) in the per-slot keys and FIFO links shared by every level; it only grows, like
+     * the rest of a policy's per-slot state.
+     */
+    void reserve(size_t slots) {
+        if (keys.size() < slots) {
+            keys.resize(slots);
+            next.resize(slots, NONE);
+        }
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    /** Adds the process in slot, which must be reserved, with the given priority and arrival time. */
+    void push(int slot, int priority, int arrivalTime) {
+        keys[slot] = Key{arrivalTime, priority, nextSequence++};
+        Level& level = levelFor(priority);
+        if (level.empty()) markOccupied(priority);
+        if (level.tail == NONE || Later{&keys}(slot, level.tail)) {
+            next[slot] = NONE;
+            if (level.tail == NONE) {
+                level.head = slot;
+            } else {
+                next[level.tail] = slot;
+            }
+            level.tail = slot;
+        } else {
+            level.requeued.push_back(slot);
+            std::push_heap(level.requeued.begin(), level.requeued.end(), Later{&keys});
+        }
+        count++;
+    }
+
+    /** Slot of the highest-priority ready process (earliest arrival, then first inserted); the array must not be empty. */
+    int top() const {
+        return first(*firstLevel());
+    }
+
+    /** Priority of the process top() returns; the array must not be empty. */
+    int topPriority() const {
+        return keys[top()].priority;
+    }
+
+    int pop() {
+        Level& level = *firstLevel();
+        int slot = first(level);
+        if (slot == level.head) {
+            level.head = next[slot];
+            if (level.head == NONE) level.tail = NONE;
+        } else {
+            std::pop_heap(level.requeued.begin(), level.requeued.end(), Later{&keys});
+            level.requeued.pop_back();
+        }
+        if (level.empty()) markEmpty(keys[slot].priority);
+        count--;
+        return slot;
+    }
+
+    /** True if at least one ready process has exactly the given priority. */
+    bool hasPriority(int priority) const {
+        if (inRange(priority)) return (bitmap[priority / 64] >> (priority % 64)) & 1;
+        return std::binary_search(occupiedSparse.begin(), occupiedSparse.end(), priority);
+    }
+
+private:
+    static const int BITMAP_WORDS = NUM_LEVELS / 64;
+
+    struct Key {
+        int arrivalTime;
+        int priority;
+        long long sequence;
+    };
+
+    /** Heap order on slots: the earlier arrival, then the earlier insertion, comes first. */
+    struct Later {
+        const std::vector<Key>* keys;
+
+        bool operator()(int a, int b) const {
+            const Key& x = (*keys)[a];
+            const Key& y = (*keys)[b];
+            if (x.arrivalTime != y.arrivalTime) return x.arrivalTime > y.arrivalTime;
+            return x.sequence > y.sequence;
+        }
+    };
+
+    struct Level {
+        int head = NONE;            // FIFO of slots pushed in order
+        int tail = NONE;
+        std::vector<int> requeued;  // Heap of slots pushed out of order
+
+        bool empty() const { return head == NONE && requeued.empty(); }
+    };
+
+    static bool inRange(int priority) { return priority >= 0 && priority < NUM_LEVELS; }
+
+    /** A sparse level is created on first use and kept once empty, so reusing its priority does not allocate. */
+    Level& levelFor(int priority) {
+        return inRange(priority) ? levels[priority] : sparse[priority];
+    }
+
+    void markOccupied(int priority) {
+        if (inRange(priority)) {
+            bitmap[priority / 64] |= (uint64_t(1) << (priority % 64));
+        } else {
+            occupiedSparse.insert(std::lower_bound(occupiedSparse.begin(), occupiedSparse.end(), priority), priority);
+        }
+    }
+
+    void markEmpty(int priority) {
+        if (inRange(priority)) {
+            bitmap[priority / 64] &= ~(uint64_t(1) << (priority % 64));
+        } else {
+            occupiedSparse.erase(std::lower_bound(occupiedSparse.begin(), occupiedSparse.end(), priority));
+        }
+    }
+
+    /** The earlier of the level's FIFO front and heap top; the level must not be empty. */
+    int first(const Level& level) const {
+        if (level.requeued.empty()) return level.head;
+        if (level.head == NONE || Later{&keys}(level.head, level.requeued.front())) return level.requeued.front();
+        return level.head;
+    }
+
+    Level* sparseLevel(int priority) const {
+        return const_cast<Level*>(&sparse.find(priority)->second);
+    }
+
+    /** Finds the highest non-empty level: negative sparse levels, then the bitmap, then the remaining sparse levels. */
+    Level* firstLevel() const {
+        if (!occupiedSparse.empty() && occupiedSparse.front() < 0) return sparseLevel(occupiedSparse.front());
+        for (int word = 0; word < BITMAP_WORDS; ++word) {
+            statsReadyScan(1);
+            if (bitmap[word] != 0) {
+                return const_cast<Level*>(&levels[word * 64 + __builtin_ctzll(bitmap[word])]);
+            }
+        }
+        return sparseLevel(occupiedSparse.front());
+    }
+
+    std::vector<Level> levels;
+    uint64_t bitmap[BITMAP_WORDS];
+    std::map<int, Level> sparse;
+    std::vector<int> occupiedSparse; // Priorities of the non-empty sparse levels, ascending
+    std::vector<Key> keys;           // Ordering key of each queued slot
+    std::vector<int> next;           // Slot behind each slot in its level's FIFO, NONE at a tail
+    size_t count;
+    long long nextSequence;
+};
+
+#endif
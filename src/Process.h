@@ -8,12 +8,15 @@
  * Stores essential process characteristics like ID, arrival time, burst time,
  * and priority, along with state variables and metrics tracked during simulation 
  * (e.g., start time, completion time, remaining time, waiting time, etc.).
+ * A process that does I/O lists its further bursts in ioCpuBursts: after its first CPU burst (burstTime) it
+ * alternately blocks for an I/O burst and runs another CPU burst, always ending with a CPU burst.
  */
 struct Process {
     int id;
     int arrivalTime;
     int burstTime;
     int priority;
+    std::vector<int> ioCpuBursts; // I/O, CPU, I/O, CPU, ... after the first CPU burst; empty for a CPU-only process
 
     int startTime = -1;
     int completionTime = -1;
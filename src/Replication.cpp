@@ -0,0 +1,295 @@
+#include "Replication.h"
+#include "SplitMix64.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <future>
+#include <stdexcept>
+#include <algorithm>
+
+void ReplicationConfig::validate() const {
+    if (replicas < 2) throw std::runtime_error("A Monte Carlo study needs at least 2 replicas");
+    if (model == ReplicaModel::Resample && (source == nullptr || source->size() == 0)) {
+        throw std::runtime_error("Resampling needs a non-empty source workload");
+    }
+    if (model == ReplicaModel::Generate) generator.validate();
+}
+
+uint64_t replicaSeed(uint64_t seed, int replica) {
+    SplitMix64 mixer(seed);
+    uint64_t base = mixer.next();
+    return SplitMix64(base ^ static_cast<uint64_t>(replica)).next();
+}
+
+std::vector<Process> resampleWorkload(const Workload& source, uint64_t seed) {
+    size_t count = source.size();
+    SplitMix64 rng(seed);
+    std::vector<Process> processes;
+    processes.reserve(count);
+    long long arrival = 0;
+    for (size_t i = 0; i < count; ++i) {
+        size_t slot = static_cast<size_t>(rng.below(count));
+        arrival += source.arrivalTimes[slot] - (slot > 0 ? source.arrivalTimes[slot - 1] : 0);
+        if (arrival > std::numeric_limits<int>::max()) {
+            throw std::runtime_error("Resampled arrival times exceed the supported range");
+        }
+        processes.push_back(source.process(slot));
+        processes.back().id = static_cast<int>(i) + 1;
+        processes.back().arrivalTime = static_cast<int>(arrival);
+    }
+    return processes;
+}
+
+GeneratorConfig fitGeneratorConfig(const Workload& source) {
+    if (source.size() == 0) throw std::runtime_error("Cannot fit a workload model to an empty workload");
+
+    GeneratorConfig config;
+    size_t count = source.size();
+    config.processCount = count;
+    config.arrivals = ArrivalPattern::Poisson;
+    double span = static_cast<double>(source.arrivalTimes.back()) - source.arrivalTimes.front();
+    config.arrivalRate = span > 0 ? (count - 1) / span : static_cast<double>(count);
+
+    // Every CPU burst counts towards the mean, whether it is a process's first burst or one after an I/O burst
+    double cpuTime = 0;
+    double cpuBursts = 0;
+    double ioTime = 0;
+    double ioBursts = 0;
+    size_t ioProcesses = 0;
+    int longest = 0;
+    std::map<int, double> priorityCounts;
+    for (size_t slot = 0; slot < count; ++slot) {
+        cpuTime += source.burstTimes[slot];
+        cpuBursts += 1;
+        longest = std::max(longest, source.burstTimes[slot]);
+        priorityCounts[source.priorities[slot]] += 1;
+
+        int length = source.burstCount(slot);
+        if (length == 0) continue;
+        const int* sequence = source.burstSequence(slot);
+        ioProcesses++;
+        for (int i = 0; i + 1 < length; i += 2) {
+            ioTime += sequence[i];
+            ioBursts += 1;
+            cpuTime += sequence[i + 1];
+            cpuBursts += 1;
+            longest = std::max(longest, std::max(sequence[i], sequence[i + 1]));
+        }
+    }
+
+    config.bursts = BurstDistribution::Exponential;
+    config.meanBurst = cpuTime / cpuBursts;
+    config.maxBurst = std::max(config.maxBurst, longest);
+    config.priorityMix.clear();
+    for (const auto& entry : priorityCounts) config.priorityMix.push_back({entry.first, entry.second});
+    if (ioProcesses > 0) {
+        config.ioFraction = static_cast<double>(ioProcesses) / count;
+        config.ioBurstCount = std::max(1, static_cast<int>(std::lround(ioBursts / ioProcesses)));
+        config.meanIo = ioTime / ioBursts;
+    }
+    return config;
+}
+
+/** Two-sided 95% quantile of Student's t distribution with the given degrees of freedom (at least 1). */
+static double studentT95(int degreesOfFreedom) {
+    static const double TABLE[30] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                     2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                     2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    if (degreesOfFreedom <= 30) return TABLE[degreesOfFreedom - 1];
+
+    // Cornish-Fisher expansion around the normal quantile; within 0.001 of the exact value from 30 degrees of freedom up
+    const double z = 1.959963985;
+    double v = degreesOfFreedom;
+    double z3 = z * z * z;
+    double z5 = z3 * z * z;
+    double z7 = z5 * z * z;
+    return z + (z3 + z) / (4 * v) + (5 * z5 + 16 * z3 + 3 * z) / (96 * v * v) +
+           (3 * z7 + 19 * z5 + 17 * z3 - 15 * z) / (384 * v * v * v);
+}
+
+/** Mean and 95% confidence half-width of metric(run) over the runs, in run order so the result is reproducible. */
+template <typename Metric>
+static MetricEstimate estimate(const std::vector<SimulationResult>& runs, Metric metric) {
+    MetricEstimate result;
+    double sum = 0;
+    for (const SimulationResult& run : runs) sum += static_cast<double>(metric(run));
+    result.mean = sum / runs.size();
+
+    double squares = 0;
+    for (const SimulationResult& run : runs) {
+        double deviation = static_cast<double>(metric(run)) - result.mean;
+        squares += deviation * deviation;
+    }
+    double variance = squares / (runs.size() - 1);
+    result.halfWidth = studentT95(static_cast<int>(runs.size()) - 1) * std::sqrt(variance / runs.size());
+    return result;
+}
+
+template <typename Select>
+static PercentileEstimates estimatePercentiles(const std::vector<SimulationResult>& runs, Select select) {
+    PercentileEstimates result;
+    result.p50 = estimate(runs, [&select](const SimulationResult& run) { return select(run).p50; });
+    result.p90 = estimate(runs, [&select](const SimulationResult& run) { return select(run).p90; });
+    result.p99 = estimate(runs, [&select](const SimulationResult& run) { return select(run).p99; });
+    result.p999 = estimate(runs, [&select](const SimulationResult& run) { return select(run).p999; });
+    result.max = estimate(runs, [&select](const SimulationResult& run) { return select(run).max; });
+    return result;
+}
+
+/** Summarises the runs of one algorithm, one per replica. */
+static ReplicatedResult aggregate(const std::vector<SimulationResult>& runs) {
+    ReplicatedResult result;
+    result.algorithmName = runs.front().algorithmName;
+    result.replicas = static_cast<int>(runs.size());
+    result.averageWaitingTime = estimate(runs, [](const SimulationResult& run) { return run.averageWaitingTime; });
+    result.averageTurnaroundTime = estimate(runs, [](const SimulationResult& run) { return run.averageTurnaroundTime; });
+    result.averageResponseTime = estimate(runs, [](const SimulationResult& run) { return run.averageResponseTime; });
+    result.cpuUtilization = estimate(runs, [](const SimulationResult& run) { return run.cpuUtilization; });
+    result.throughput = estimate(runs, [](const SimulationResult& run) { return run.throughput; });
+    result.totalElapsedTime = estimate(runs, [](const SimulationResult& run) { return run.totalElapsedTime; });
+    result.totalProcessesCompleted = estimate(runs, [](const SimulationResult& run) { return run.totalProcessesCompleted; });
+    result.waitingPercentiles = estimatePercentiles(runs, [](const SimulationResult& run) -> const LatencyPercentiles& { return run.waitingPercentiles; });
+    result.turnaroundPercentiles = estimatePercentiles(runs, [](const SimulationResult& run) -> const LatencyPercentiles& { return run.turnaroundPercentiles; });
+    result.responsePercentiles = estimatePercentiles(runs, [](const SimulationResult& run) -> const LatencyPercentiles& { return run.responsePercentiles; });
+    result.contextSwitches = estimate(runs, [](const SimulationResult& run) { return run.contextSwitches; });
+    result.preemptions = estimate(runs, [](const SimulationResult& run) { return run.preemptions; });
+    result.contextSwitchTime = estimate(runs, [](const SimulationResult& run) { return run.contextSwitchTime; });
+    result.ioRequests = estimate(runs, [](const SimulationResult& run) { return run.ioRequests; });
+    result.ioUtilization = estimate(runs, [](const SimulationResult& run) { return run.ioUtilization; });
+    result.averageIoWait = estimate(runs, [](const SimulationResult& run) {
+        return run.ioRequests > 0 ? static_cast<double>(run.ioWaitTime) / run.ioRequests : 0.0;
+    });
+    return result;
+}
+
+std::vector<ReplicatedResult> runReplicas(const ReplicationConfig& config, const std::vector<ReplicaPolicy>& policies, ThreadPool& pool) {
+    config.validate();
+
+    std::vector<std::future<std::vector<SimulationResult>>> pending;
+    for (int replica = 0; replica < config.replicas; ++replica) {
+        pending.push_back(pool.submit([&config, &policies, replica] {
+            uint64_t seed = replicaSeed(config.seed, replica);
+            std::vector<Process> processes;
+            if (config.model == ReplicaModel::Generate) {
+                GeneratorConfig generator = config.generator;
+                generator.seed = seed;
+                processes = generateWorkload(generator, 1); // The pool already runs one replica per thread
+            } else {
+                processes = resampleWorkload(*config.source, seed);
+            }
+            const Workload workload(std::move(processes));
+
+            std::vector<SimulationResult> results;
+            for (const ReplicaPolicy& policy : policies) results.push_back(policy(workload));
+            return results;
+        }));
+    }
+
+    // Collected in submission order, so every estimate sums its samples in replica order
+    std::vector<std::vector<SimulationResult>> byPolicy(policies.size());
+    for (auto& future : pending) {
+        std::vector<SimulationResult> results = future.get();
+        for (size_t i = 0; i < results.size(); ++i) byPolicy[i].push_back(results[i]);
+    }
+
+    std::vector<ReplicatedResult> replicated;
+    for (const std::vector<SimulationResult>& runs : byPolicy) replicated.push_back(aggregate(runs));
+    return replicated;
+}
+
+/** Formats an estimate as "mean +/- half-width" for one table cell. */
+static std::string formatEstimate(const MetricEstimate& estimate, int precision = 2) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(precision) << estimate.mean << " +/- " << estimate.halfWidth;
+    return text.str();
+}
+
+/**
+ * Prints the replicated averages, the p99 latencies and makespan, and the context switches, each cell as mean +/-
+ * the half-width of its 95% confidence interval, followed by the I/O metrics if any replica did I/O.
+ */
+void printReplicatedResults(const std::vector<ReplicatedResult>& results) {
+    if (results.empty()) return;
+
+    size_t nameWidth = 45;
+    bool io = false;
+    for (const auto& result : results) {
+        nameWidth = std::max(nameWidth, result.algorithmName.size() + 1);
+        io = io || result.ioRequests.mean > 0;
+    }
+    const int width = 24;
+
+    std::cout << "\n--- Monte Carlo Estimates (" << results.front().replicas << " replicas, mean +/- 95% CI) ---" << std::endl;
+    std::cout << std::left << std::setw(nameWidth) << "Algorithm"
+              << std::setw(width) << "Avg Waiting"
+              << std::setw(width) << "Avg Turnaround"
+              << std::setw(width) << "Avg Response"
+              << std::setw(width) << "CPU Util (%)"
+              << std::setw(width) << "Throughput (proc/unit)"
+              << std::endl;
+    std::cout << std::string(nameWidth + 5 * width, '-') << std::endl;
+    for (const auto& result : results) {
+        std::cout << std::left << std::setw(nameWidth) << result.algorithmName
+                  << std::setw(width) << formatEstimate(result.averageWaitingTime)
+                  << std::setw(width) << formatEstimate(result.averageTurnaroundTime)
+                  << std::setw(width) << formatEstimate(result.averageResponseTime)
+                  << std::setw(width) << formatEstimate(result.cpuUtilization)
+                  << std::setw(width) << formatEstimate(result.throughput, 4)
+                  << std::endl;
+    }
+    std::cout << "----------------------------" << std::endl;
+
+    std::cout << "\n--- Tail Latency and Makespan (mean +/- 95% CI) ---" << std::endl;
+    std::cout << std::left << std::setw(nameWidth) << "Algorithm"
+              << std::setw(width) << "p99 Waiting"
+              << std::setw(width) << "p99 Turnaround"
+              << std::setw(width) << "p99 Response"
+              << std::setw(width) << "Elapsed Time"
+              << std::endl;
+    std::cout << std::string(nameWidth + 4 * width, '-') << std::endl;
+    for (const auto& result : results) {
+        std::cout << std::left << std::setw(nameWidth) << result.algorithmName
+                  << std::setw(width) << formatEstimate(result.waitingPercentiles.p99)
+                  << std::setw(width) << formatEstimate(result.turnaroundPercentiles.p99)
+                  << std::setw(width) << formatEstimate(result.responsePercentiles.p99)
+                  << std::setw(width) << formatEstimate(result.totalElapsedTime)
+                  << std::endl;
+    }
+    std::cout << "----------------------------" << std::endl;
+
+    std::cout << "\n--- Context Switches (mean +/- 95% CI) ---" << std::endl;
+    std::cout << std::left << std::setw(nameWidth) << "Algorithm"
+              << std::setw(width) << "Switches"
+              << std::setw(width) << "Preemptions"
+              << std::setw(width) << "Switch Time"
+              << std::endl;
+    std::cout << std::string(nameWidth + 3 * width, '-') << std::endl;
+    for (const auto& result : results) {
+        std::cout << std::left << std::setw(nameWidth) << result.algorithmName
+                  << std::setw(width) << formatEstimate(result.contextSwitches)
+                  << std::setw(width) << formatEstimate(result.preemptions)
+                  << std::setw(width) << formatEstimate(result.contextSwitchTime)
+                  << std::endl;
+    }
+    std::cout << "----------------------------" << std::endl;
+
+    if (!io) return;
+    std::cout << "\n--- CPU and I/O (mean +/- 95% CI) ---" << std::endl;
+    std::cout << std::left << std::setw(nameWidth) << "Algorithm"
+              << std::setw(width) << "I/O Requests"
+              << std::setw(width) << "I/O Util (%)"
+              << std::setw(width) << "Avg I/O Wait"
+              << std::endl;
+    std::cout << std::string(nameWidth + 3 * width, '-') << std::endl;
+    for (const auto& result : results) {
+        std::cout << std::left << std::setw(nameWidth) << result.algorithmName
+                  << std::setw(width) << formatEstimate(result.ioRequests)
+                  << std::setw(width) << formatEstimate(result.ioUtilization)
+                  << std::setw(width) << formatEstimate(result.averageIoWait)
+                  << std::endl;
+    }
+    std::cout << "----------------------------" << std::endl;
+}
@@ -0,0 +1,101 @@
+#ifndef REPLICATION_H
+#define REPLICATION_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <functional>
+#include "Process.h"
+#include "Scheduler.h"
+#include "ThreadPool.h"
+#include "WorkloadGenerator.h"
+
+/** Where the replica workloads of a Monte Carlo study come from. */
+enum class ReplicaModel {
+    Generate, // The generator configuration, with its seed replaced by each replica's seed
+    Resample  // A bootstrap resample of a source workload (see resampleWorkload)
+};
+
+/** A Monte Carlo study: how many replicas to run and how the workload of each one is drawn. */
+struct ReplicationConfig {
+    int replicas = 30;
+    uint64_t seed = 1;                   // The only seed of the study; replica r draws from replicaSeed(seed, r)
+    ReplicaModel model = ReplicaModel::Resample;
+    GeneratorConfig generator;           // Generate: the workload model
+    const Workload* source = nullptr;    // Resample: the workload to resample, which must outlive the study
+
+    /** Throws runtime error for fewer than 2 replicas, a missing source or an invalid generator configuration. */
+    void validate() const;
+};
+
+/** One algorithm as a study runs it; called concurrently on the workloads of different replicas. */
+typedef std::function<SimulationResult(const Workload&)> ReplicaPolicy;
+
+/** Mean of one metric over the replicas and the half-width of its 95% confidence interval (Student's t). */
+struct MetricEstimate {
+    double mean = 0;
+    double halfWidth = 0;
+};
+
+/** MetricEstimates of the five points of a LatencyPercentiles summary. */
+struct PercentileEstimates {
+    MetricEstimate p50;
+    MetricEstimate p90;
+    MetricEstimate p99;
+    MetricEstimate p999;
+    MetricEstimate max;
+};
+
+/** The single-CPU metrics of SimulationResult, each estimated over the replicas of one algorithm. */
+struct ReplicatedResult {
+    std::string algorithmName;
+    int replicas = 0;
+    MetricEstimate averageWaitingTime;
+    MetricEstimate averageTurnaroundTime;
+    MetricEstimate averageResponseTime;
+    MetricEstimate cpuUtilization;
+    MetricEstimate throughput;
+    MetricEstimate totalElapsedTime;
+    MetricEstimate totalProcessesCompleted;
+    PercentileEstimates waitingPercentiles;
+    PercentileEstimates turnaroundPercentiles;
+    PercentileEstimates responsePercentiles;
+    MetricEstimate contextSwitches;
+    MetricEstimate preemptions;
+    MetricEstimate contextSwitchTime;
+    MetricEstimate ioRequests;
+    MetricEstimate ioUtilization;
+    MetricEstimate averageIoWait; // ioWaitTime per I/O request; 0 in replicas without I/O
+};
+
+/**
+ * Seed of replica r's random stream, derived from the study seed alone, so each replica draws the same workload
+ * whichever thread runs it and however many threads there are.
+ */
+uint64_t replicaSeed(uint64_t seed, int replica);
+
+/**
+ * Bootstrap resample of source: as many processes, each a copy of a uniformly drawn source process (bursts and
+ * priority included) arriving the drawn process's inter-arrival gap after the previous one. IDs are 1..n in arrival order.
+ * Throws runtime error if the resampled arrival times exceed the int range.
+ */
+std::vector<Process> resampleWorkload(const Workload& source, uint64_t seed);
+
+/**
+ * Generator parameters fitted to source: Poisson arrivals at the observed rate, exponential CPU bursts with the
+ * observed mean, the observed priority frequencies and, if source does I/O, its share of I/O processes, mean number
+ * of I/O bursts per such process and mean I/O length. processCount is source's size.
+ */
+GeneratorConfig fitGeneratorConfig(const Workload& source);
+
+/**
+ * Runs every policy on the workload of every replica, one replica per pool task (the replica's workload is built
+ * inside the task and shared by its policies). Results are aggregated in replica order, so they depend only on
+ * the configuration and not on the pool size. Returns one ReplicatedResult per policy, in the given order.
+ */
+std::vector<ReplicatedResult> runReplicas(const ReplicationConfig& config, const std::vector<ReplicaPolicy>& policies, ThreadPool& pool);
+
+/** Prints the averages, p99 latencies, context switches and (if any run did I/O) I/O metrics as mean +/- 95% CI. */
+void printReplicatedResults(const std::vector<ReplicatedResult>& results);
+
+#endif
@@ -1,319 +1,299 @@
 #include "Scheduler.h"
+#include "SimulationEngine.h"
+#include "IndexedHeap.h"
+#include "PriorityArray.h"
+#include "SlotQueue.h"
 #include <iostream>
 #include <vector>
-#include <numeric>
 #include <algorithm>
 #include <iomanip> 
-#include <queue>   
 #include <limits> 
-#include <list> 
+#include <array>
+#include <stdexcept>
 
-/**
- * Calculates final performance metrics after a simulation run.
- * Computes average waiting time, average turnaround time, average response time, CPU utilization, and throughput based on the state of completed processes and the total simulation time.
- * Updates the passed SimulationResult structure with these calculated metrics.
- */
-void calculateMetrics(SimulationResult& result, std::vector<Process>& completedProcesses, int currentTime, int totalIdleTime) {
-    if (completedProcesses.empty()) {
-        result.totalProcessesCompleted = 0;
-        result.totalElapsedTime = currentTime;
-        return; 
+void OnlineMetrics::record(int arrivalTime, int burstTime, const ProcessState& state) {
+    int turnaroundTime = state.completionTime - arrivalTime;
+    recordTimes(std::max(0, turnaroundTime - burstTime), turnaroundTime, state.responseTime);
+}
+
+void OnlineMetrics::recordTimes(int waitingTime, int turnaroundTime, int responseTime) {
+    totalWaitingTime += waitingTime;
+    totalTurnaroundTime += turnaroundTime;
+    waitingTimes.record(waitingTime);
+    turnaroundTimes.record(turnaroundTime);
+    if (responseTime != -1) {
+        totalResponseTime += responseTime;
+        validResponseTimes++;
+        responseTimes.record(responseTime);
     }
+    completed++;
+}
 
-    double totalWaitingTime = 0;
-    double totalTurnaroundTime = 0;
-    double totalResponseTime = 0;
-    int validResponseTimes = 0;
+void OnlineMetrics::fill(SimulationResult& result, int currentTime, int totalIdleTime, long long contextSwitchTime) const {
+    result.totalProcessesCompleted = completed;
+    result.totalElapsedTime = currentTime;
+    result.contextSwitchTime = contextSwitchTime;
+    if (completed == 0) return;
 
-    // Ensure completed processes are sorted by ID for consistent metric calculation viewing (optional)
-    std::sort(completedProcesses.begin(), completedProcesses.end(), [](const Process& a, const Process& b) {
-        return a.id < b.id;
-    });
+    result.averageWaitingTime = totalWaitingTime / completed;
+    result.averageTurnaroundTime = totalTurnaroundTime / completed;
+    result.averageResponseTime = (validResponseTimes > 0) ? (totalResponseTime / validResponseTimes) : 0.0;
+
+    long long totalBusyTime = currentTime - totalIdleTime - contextSwitchTime;
+    result.cpuUtilization = (currentTime > 0) ? (static_cast<double>(totalBusyTime) / currentTime * 100.0) : 0.0;
+    result.throughput = (currentTime > 0) ? (static_cast<double>(completed) / currentTime) : 0.0;
 
-    for (auto& p : completedProcesses) {
-        // Final calculation based on completion and start times
-        p.turnaroundTime = p.completionTime - p.arrivalTime;
-        p.waitingTime = p.turnaroundTime - p.burstTime; 
+    result.waitingPercentiles = waitingTimes.percentiles();
+    result.turnaroundPercentiles = turnaroundTimes.percentiles();
+    result.responsePercentiles = responseTimes.percentiles();
+}
 
-        if (p.waitingTime < 0) p.waitingTime = 0; 
+void ContextSwitchCost::validate() const {
+    if (voluntary < 0) throw std::runtime_error("The context switch cost must not be negative");
+    if (preemption < 0) throw std::runtime_error("The preemption switch cost must not be negative");
+}
 
-        totalWaitingTime += p.waitingTime;
-        totalTurnaroundTime += p.turnaroundTime;
-        if (p.responseTime != -1) {
-            totalResponseTime += p.responseTime; 
-            validResponseTimes++;
-        }
+void SimulationOptions::validate() const {
+    contextSwitch.validate();
+    if (ioDevices < 1) throw std::runtime_error("The number of I/O devices must be at least 1");
+}
+
+/** FCFS ready queue: processes are dispatched strictly in arrival order and never preempted. */
+class FcfsPolicy final : public SchedulingPolicy {
+public:
+    void reserveSlots(size_t count) override {
+        readyQueue.reserve(count);
     }
 
-    int n = completedProcesses.size();
-    result.totalProcessesCompleted = n;
-    result.totalElapsedTime = currentTime;
-    result.averageWaitingTime = totalWaitingTime / n;
-    result.averageTurnaroundTime = totalTurnaroundTime / n;
-    result.averageResponseTime = (validResponseTimes > 0) ? (totalResponseTime / validResponseTimes) : 0.0;
+    void admit(int slot, int /*currentTime*/) override {
+        readyQueue.push(slot);
+        statsReadyInsert();
+    }
 
-    int totalBusyTime = currentTime - totalIdleTime;
-    result.cpuUtilization = (currentTime > 0) ? (static_cast<double>(totalBusyTime) / currentTime * 100.0) : 0.0;
-    result.throughput = (currentTime > 0) ? (static_cast<double>(n) / currentTime) : 0.0;
-}
+    int schedule(int running, int /*currentTime*/, bool /*sliceExpired*/) override {
+        if (running != NO_PROCESS || readyQueue.empty()) return running;
+        statsReadyRemove();
+        return readyQueue.pop();
+    }
+
+    int steal() override {
+        return schedule(NO_PROCESS, 0, false);
+    }
+
+    std::unique_ptr<SchedulingPolicy> clone() const override {
+        return std::unique_ptr<SchedulingPolicy>(new FcfsPolicy());
+    }
+
+    std::unique_ptr<SchedulingPolicy> copy() const override {
+        return std::unique_ptr<SchedulingPolicy>(new FcfsPolicy(*this));
+    }
+
+private:
+    SlotQueue readyQueue;
+};
 
 /**
  * Simulates the First-Come, First-Served (FCFS) scheduling algorithm.
  * Processes are executed strictly in the order of their arrival time.
  * It is non-preemptive. Processes arriving are added to a ready queue.
- * The simulation proceeds time unit by time unit, handling arrivals, execution, completion, and idle time.
+ * The simulation jumps from event to event, handling arrivals, execution, completion, and idle time.
  */
-SimulationResult runFCFS(std::vector<Process> processes) {
-    SimulationResult result("FCFS");
-    std::vector<Process> completedProcesses;
-    completedProcesses.reserve(processes.size());
-    std::list<Process*> readyQueue;
-    int currentTime = 0;
-    int totalIdleTime = 0;
-    size_t processIdx = 0;
-    int completedCount = 0;
-
-    // Sort processes by arrival time initially
-    std::sort(processes.begin(), processes.end(), [](const Process& a, const Process& b) {
-        if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
-        return a.id < b.id;
-    });
+SimulationResult runFCFS(const Workload& workload, const SimulationOptions& options) {
+    SimulationEngine engine(workload, options);
+    FcfsPolicy policy;
+    return engine.run(policy, "FCFS");
+}
 
-    Process* runningProcess = nullptr;
+SimulationResult runFCFS(const std::vector<Process>& processes, const SimulationOptions& options) {
+    return runFCFS(Workload(processes), options);
+}
 
-    while (completedCount < processes.size()) {
-        // Add newly arrived processes to the ready queue
-        while (processIdx < processes.size() && processes[processIdx].arrivalTime <= currentTime) {
-            readyQueue.push_back(&processes[processIdx]);
-            processIdx++;
-        }
+/**
+ * SJF ready queue: when the CPU is free, the process with the shortest next CPU burst is selected.
+ * Kept in an indexed min-heap keyed on (burst, arrival, insertion order), so selection is O(log n).
+ * The burst is the remaining time when the process becomes ready: its whole burst on arrival, its next CPU burst
+ * after I/O, and its burst plus the migration cost after work stealing.
+ */
+class SjfPolicy final : public SchedulingPolicy {
+public:
+    SjfPolicy() : nextSequence(0) {}
 
-        // If CPU is idle and ready queue is not empty, start the next process
-        if (runningProcess == nullptr && !readyQueue.empty()) {
-            runningProcess = readyQueue.front();
-            readyQueue.pop_front();
-            
-            if (runningProcess->startTime == -1) {
-                runningProcess->startTime = currentTime;
-                runningProcess->responseTime = runningProcess->startTime - runningProcess->arrivalTime;
-            }
-        }
+    void reserveSlots(size_t count) override {
+        readyQueue.reserve(count);
+    }
 
-        // If CPU is running a process
-        if (runningProcess != nullptr) {
-            currentTime++;
-            runningProcess->remainingBurstTime--;
-
-            // Check for completion
-            if (runningProcess->remainingBurstTime == 0) {
-                runningProcess->completionTime = currentTime;
-                completedProcesses.push_back(*runningProcess);
-                completedCount++;
-                runningProcess = nullptr; // CPU becomes free
-            }
-        } else { 
-            // CPU is idle
-            if (processIdx < processes.size() || !readyQueue.empty()) {
-                 // If there are processes waiting or yet to arrive, but not ready right now, advance time to the next arrival if ready queue is empty
-                if(readyQueue.empty() && processIdx < processes.size()) {
-                    int idleStart = currentTime;
-                    currentTime = processes[processIdx].arrivalTime;
-                    totalIdleTime += (currentTime - idleStart);
-                } else {
-                     currentTime++;
-                     totalIdleTime++;
-                }
-            } else {
-                 break; 
-            }
-        }
+    void admit(int slot, int /*currentTime*/) override {
+        readyQueue.push(slot, ReadyKey{remainingBurstTime(slot), arrivalTime(slot), nextSequence++});
+        statsReadyInsert();
     }
 
-    calculateMetrics(result, completedProcesses, currentTime, totalIdleTime);
-    return result;
-}
+    int schedule(int running, int /*currentTime*/, bool /*sliceExpired*/) override {
+        if (running != NO_PROCESS || readyQueue.empty()) return running;
+        statsReadyRemove();
+        return readyQueue.pop(); // Shortest job in ready queue
+    }
+
+    int steal() override {
+        return schedule(NO_PROCESS, 0, false);
+    }
+
+    std::unique_ptr<SchedulingPolicy> clone() const override {
+        return std::unique_ptr<SchedulingPolicy>(new SjfPolicy());
+    }
+
+    std::unique_ptr<SchedulingPolicy> copy() const override {
+        return std::unique_ptr<SchedulingPolicy>(new SjfPolicy(*this));
+    }
+
+private:
+    IndexedMinHeap<ReadyKey> readyQueue;
+    long long nextSequence;
+};
 
 /**
  * Simulates the non-preemptive Shortest Job First (SJF) scheduling algorithm.
- * When the CPU is free, the process in the ready queue with the shortest original burst time is selected to run. Once started, it runs to completion.
+ * When the CPU is free, the process in the ready queue with the shortest (next) burst time is selected to run. Once started, it runs to completion.
  * Handles arrivals, execution based on shortest burst, completion, and idle time.
  */
-SimulationResult runSJF(std::vector<Process> processes) {
-    SimulationResult result("SJF (Non-Preemptive)");
-    std::vector<Process> completedProcesses;
-    completedProcesses.reserve(processes.size());
-    std::list<Process*> readyQueue; // Use pointers
-    int currentTime = 0;
-    int totalIdleTime = 0;
-    size_t processIdx = 0;
-    int completedCount = 0;
-
-    // Sort initially by arrival time for processing arrivals correctly
-    std::sort(processes.begin(), processes.end(), [](const Process& a, const Process& b) {
-        if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
-        return a.id < b.id;
-    });
+SimulationResult runSJF(const Workload& workload, const SimulationOptions& options) {
+    SimulationEngine engine(workload, options);
+    SjfPolicy policy;
+    return engine.run(policy, "SJF (Non-Preemptive)");
+}
 
-    Process* runningProcess = nullptr;
+SimulationResult runSJF(const std::vector<Process>& processes, const SimulationOptions& options) {
+    return runSJF(Workload(processes), options);
+}
 
-    while (completedCount < processes.size()) {
-        // Add newly arrived processes to the ready queue
-        while (processIdx < processes.size() && processes[processIdx].arrivalTime <= currentTime) {
-            readyQueue.push_back(&processes[processIdx]);
-            processIdx++;
-        }
+/**
+ * SRTF ready queue: at every decision point the process with the shortest remaining time among the
+ * running process and the ready queue is selected, preempting the running process if needed.
+ * Ready processes live in an indexed min-heap keyed on (remaining time, arrival, insertion order).
+ */
+class SrtfPolicy final : public SchedulingPolicy {
+public:
+    SrtfPolicy() : nextSequence(0) {}
 
-        // If CPU is idle and ready queue is not empty, select the shortest job
-        if (runningProcess == nullptr && !readyQueue.empty()) {
-            // Find shortest job in ready queue
-            auto shortestIt = std::min_element(readyQueue.begin(), readyQueue.end(), 
-                [](const Process* a, const Process* b) {
-                    if(a->burstTime != b->burstTime) return a->burstTime < b->burstTime;
-                    return a->arrivalTime < b->arrivalTime;
-            });
-            runningProcess = *shortestIt;
-            readyQueue.erase(shortestIt);
-
-            if (runningProcess->startTime == -1) {
-                runningProcess->startTime = currentTime;
-                runningProcess->responseTime = runningProcess->startTime - runningProcess->arrivalTime;
-            }
-        }
+    void reserveSlots(size_t count) override {
+        readyList.reserve(count);
+    }
 
-        // If CPU is running a process
-        if (runningProcess != nullptr) {
-            int timeToRun = runningProcess->burstTime; // Run the whole burst
-            // Update current time
-            currentTime += timeToRun;
-            runningProcess->remainingBurstTime = 0;
-            runningProcess->completionTime = currentTime;
-            completedProcesses.push_back(*runningProcess);
-            completedCount++;
-            runningProcess = nullptr; // CPU becomes free
-        } else { 
-            // CPU is idle
-             if (processIdx < processes.size() || !readyQueue.empty()) {
-                if(readyQueue.empty() && processIdx < processes.size()) {
-                    int idleStart = currentTime;
-                    currentTime = processes[processIdx].arrivalTime;
-                    totalIdleTime += (currentTime - idleStart);
-                } else {
-                     currentTime++;
-                     totalIdleTime++;
-                }
-             } else {
-                 break; // No more processes
-             }
+    void admit(int slot, int /*currentTime*/) override {
+        enqueue(slot);
+    }
+
+    int schedule(int running, int /*currentTime*/, bool /*sliceExpired*/) override {
+        if (readyList.empty()) return running;
+        // Tie-breaking: a ready process with equal remaining time wins over the running one
+        if (running != NO_PROCESS && remainingBurstTime(running) < readyList.topKey().primary) return running;
+
+        int shortestProcess = readyList.pop();
+        statsReadyRemove();
+        if (running != NO_PROCESS) { // Preempt
+            enqueue(running); // Put running process back in ready queue
         }
+        return shortestProcess;
     }
 
-    calculateMetrics(result, completedProcesses, currentTime, totalIdleTime);
-    return result;
-}
+    int steal() override {
+        if (readyList.empty()) return NO_PROCESS;
+        statsReadyRemove();
+        return readyList.pop();
+    }
+
+    std::unique_ptr<SchedulingPolicy> clone() const override {
+        return std::unique_ptr<SchedulingPolicy>(new SrtfPolicy());
+    }
+
+    std::unique_ptr<SchedulingPolicy> copy() const override {
+        return std::unique_ptr<SchedulingPolicy>(new SrtfPolicy(*this));
+    }
+
+private:
+    void enqueue(int slot) {
+        readyList.push(slot, ReadyKey{remainingBurstTime(slot), arrivalTime(slot), nextSequence++});
+        statsReadyInsert();
+    }
+
+    IndexedMinHeap<ReadyKey> readyList;
+    long long nextSequence;
+};
 
 /**
  * Simulates the preemptive Shortest Remaining Time First (SRTF) scheduling algorithm.
- * At any time unit (or upon arrival), the process with the shortest remaining burst time among the running process and all processes in the ready list is selected.
+ * At every arrival or completion, the process with the shortest remaining burst time among the running process and all processes in the ready list is selected.
  * If a new arrival has a shorter remaining time than the currently running process, the running process is preempted.
  */
-SimulationResult runSRTF(std::vector<Process> processes) {
-    SimulationResult result("SRTF (Preemptive SJF)");
-    std::vector<Process> completedProcesses;
-    completedProcesses.reserve(processes.size());
-    std::list<Process*> readyList;
-    int currentTime = 0;
-    int totalIdleTime = 0;
-    size_t processIdx = 0;
-    int completedCount = 0;
-
-    std::sort(processes.begin(), processes.end(), [](const Process& a, const Process& b) {
-        if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
-        return a.id < b.id;
-    });
+SimulationResult runSRTF(const Workload& workload, const SimulationOptions& options) {
+    SimulationEngine engine(workload, options);
+    SrtfPolicy policy;
+    return engine.run(policy, "SRTF (Preemptive SJF)");
+}
+
+SimulationResult runSRTF(const std::vector<Process>& processes, const SimulationOptions& options) {
+    return runSRTF(Workload(processes), options);
+}
 
-    Process* runningProcess = nullptr;
+/**
+ * Priority ready queue (lower number means higher priority), preemptive or non-preemptive.
+ * Backed by a PriorityArray, so picking the next process is a find-first-set over the occupancy bitmap.
+ * In preemptive mode a ready process with equal priority also displaces the running one, so while such a
+ * tie exists the running process is only given a one-unit slice before the next decision point.
+ */
+class PriorityPolicy final : public SchedulingPolicy {
+public:
+    explicit PriorityPolicy(bool preemptive) : preemptive(preemptive) {}
 
-    while (completedCount < processes.size()) {
-        // Add newly arrived processes
-        while (processIdx < processes.size() && processes[processIdx].arrivalTime <= currentTime) {
-            readyList.push_back(&processes[processIdx]);
-            processIdx++;
-        }
+    void reserveSlots(size_t count) override {
+        readyList.reserve(count);
+    }
 
-        // Find the process with the shortest remaining time from ready list + potentially running process
-        Process* shortestProcess = nullptr;
-        int minRemainingTime = std::numeric_limits<int>::max();
+    void admit(int slot, int /*currentTime*/) override {
+        enqueue(slot);
+    }
 
-        // Consider currently running process for preemption
-        if (runningProcess) {
-             shortestProcess = runningProcess;
-             minRemainingTime = runningProcess->remainingBurstTime;
-        }
-        
-        // Find shortest in ready list
-        for (Process* p : readyList) {
-             if (p->remainingBurstTime < minRemainingTime) {
-                 minRemainingTime = p->remainingBurstTime;
-                 shortestProcess = p;
-             } else if (p->remainingBurstTime == minRemainingTime) {
-                 // Tie-breaking: prefer the one already running, then by arrival time
-                 if (shortestProcess == runningProcess || p->arrivalTime < shortestProcess->arrivalTime) {
-                     shortestProcess = p;
-                 } 
-             }
+    int schedule(int running, int /*currentTime*/, bool /*sliceExpired*/) override {
+        if (readyList.empty()) return running;
+        if (running != NO_PROCESS) {
+            // Non-preemptive: only select when CPU is idle
+            if (!preemptive || priority(running) < readyList.topPriority()) return running;
+            // Preemptive: the highest priority ready process wins ties against the running one
+            int highestPriorityProcess = readyList.pop();
+            statsReadyRemove();
+            enqueue(running);
+            return highestPriorityProcess;
         }
+        statsReadyRemove();
+        return readyList.pop();
+    }
 
-        // Preemption check or new process selection
-        if (shortestProcess != nullptr && shortestProcess != runningProcess) {
-            if (runningProcess != nullptr) { // Preempt
-                readyList.push_back(runningProcess); // Put running process back in ready list
-            }
-            runningProcess = shortestProcess;
-             // Remove the selected process from ready list
-            readyList.remove(runningProcess);
-            
-            if (runningProcess->startTime == -1) { 
-                runningProcess->startTime = currentTime;
-                runningProcess->responseTime = runningProcess->startTime - runningProcess->arrivalTime;
-            }
-        }
+    int sliceLength(int slot) const override {
+        if (preemptive && readyList.hasPriority(priority(slot))) return 1; // Equal priority waiting: re-decide next unit
+        return UNBOUNDED_SLICE;
+    }
 
-        // Execute or handle idle time
-        if (runningProcess != nullptr) {
-            currentTime++;
-            runningProcess->remainingBurstTime--;
+    int steal() override {
+        if (readyList.empty()) return NO_PROCESS;
+        statsReadyRemove();
+        return readyList.pop();
+    }
 
-            if (runningProcess->remainingBurstTime == 0) {
-                runningProcess->completionTime = currentTime;
-                completedProcesses.push_back(*runningProcess);
-                completedCount++;
-                runningProcess = nullptr; // CPU is free
-            }
-        } else {
-            // CPU is idle
-            if (processIdx < processes.size() || !readyList.empty()) {
-                 if(readyList.empty() && processIdx < processes.size()) {
-                    int idleStart = currentTime;
-                    currentTime = processes[processIdx].arrivalTime;
-                    totalIdleTime += (currentTime - idleStart);
-                } else {
-                     currentTime++; 
-                     totalIdleTime++;
-                }
-            } else {
-                break; // No more processes
-            }
-        }
+    std::unique_ptr<SchedulingPolicy> clone() const override {
+        return std::unique_ptr<SchedulingPolicy>(new PriorityPolicy(preemptive));
     }
 
-    calculateMetrics(result, completedProcesses, currentTime, totalIdleTime);
-    return result;
-}
+    std::unique_ptr<SchedulingPolicy> copy() const override {
+        return std::unique_ptr<SchedulingPolicy>(new PriorityPolicy(*this));
+    }
 
-// Helper for priority comparison (lower number means higher priority)
-auto comparePriority = [](const Process* a, const Process* b) {
-    if (a->priority != b->priority) return a->priority < b->priority;
-    return a->arrivalTime < b->arrivalTime;
+private:
+    void enqueue(int slot) {
+        readyList.push(slot, priority(slot), arrivalTime(slot));
+        statsReadyInsert();
+    }
+
+    bool preemptive;
+    PriorityArray readyList;
 };
 
 /**
@@ -323,120 +303,62 @@ auto comparePriority = [](const Process* a, const Process* b) {
  * If preemptive, a running process can be interrupted if a higher priority process arrives.
  * Tie-breaking is done by arrival time.
  */
-SimulationResult runPriority(std::vector<Process> processes, bool preemptive) {
-    SimulationResult result(preemptive ? "Priority (Preemptive)" : "Priority (Non-Preemptive)");
-    std::vector<Process> completedProcesses;
-    completedProcesses.reserve(processes.size());
-    std::list<Process*> readyList;
-    int currentTime = 0;
-    int totalIdleTime = 0;
-    size_t processIdx = 0;
-    int completedCount = 0;
-
-    std::sort(processes.begin(), processes.end(), [](const Process& a, const Process& b) {
-        if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
-        return a.id < b.id;
-    });
+SimulationResult runPriority(const Workload& workload, bool preemptive, const SimulationOptions& options) {
+    SimulationEngine engine(workload, options);
+    PriorityPolicy policy(preemptive);
+    return engine.run(policy, preemptive ? "Priority (Preemptive)" : "Priority (Non-Preemptive)");
+}
 
-    Process* runningProcess = nullptr;
+SimulationResult runPriority(const std::vector<Process>& processes, bool preemptive, const SimulationOptions& options) {
+    return runPriority(Workload(processes), preemptive, options);
+}
 
-    while (completedCount < processes.size()) {
-        // Add newly arrived processes
-        while (processIdx < processes.size() && processes[processIdx].arrivalTime <= currentTime) {
-            readyList.push_back(&processes[processIdx]);
-            processIdx++;
-        }
+/** Round Robin FIFO ready queue; the running process is requeued at the back when its quantum expires. */
+class RoundRobinPolicy final : public SchedulingPolicy {
+public:
+    explicit RoundRobinPolicy(int timeQuantum) : timeQuantum(timeQuantum) {}
 
-        if (preemptive) {
-            // Preemptive logic: Find highest priority process
-            Process* highestPriorityProcess = nullptr;
-            int minPriority = std::numeric_limits<int>::max();
+    void reserveSlots(size_t count) override {
+        readyQueue.reserve(count);
+    }
 
-            if (runningProcess) {
-                highestPriorityProcess = runningProcess;
-                minPriority = runningProcess->priority;
-            }
+    void admit(int slot, int /*currentTime*/) override {
+        readyQueue.push(slot);
+        statsReadyInsert();
+    }
 
-            for (Process* p : readyList) {
-                 if (p->priority < minPriority) {
-                     minPriority = p->priority;
-                     highestPriorityProcess = p;
-                 } else if (p->priority == minPriority) {
-                     if (highestPriorityProcess == runningProcess || p->arrivalTime < highestPriorityProcess->arrivalTime) {
-                         highestPriorityProcess = p;
-                     }
-                 }
-            }
+    int schedule(int running, int /*currentTime*/, bool sliceExpired) override {
+        if (running != NO_PROCESS) {
+            if (!sliceExpired) return running;
+            // Arrivals at this instant were admitted first, so the expired process goes behind them
+            readyQueue.push(running);
+            statsReadyInsert();
+        }
+        if (readyQueue.empty()) return NO_PROCESS;
+        statsReadyRemove();
+        return readyQueue.pop();
+    }
 
-            // Preemption check
-            if (highestPriorityProcess != nullptr && highestPriorityProcess != runningProcess) {
-                if (runningProcess != nullptr) {
-                    readyList.push_back(runningProcess);
-                }
-                runningProcess = highestPriorityProcess;
-                readyList.remove(runningProcess);
+    int sliceLength(int /*slot*/) const override {
+        return timeQuantum;
+    }
 
-                if (runningProcess->startTime == -1) {
-                    runningProcess->startTime = currentTime;
-                    runningProcess->responseTime = runningProcess->startTime - runningProcess->arrivalTime;
-                }
-            }
-        } else {
-            // Non-preemptive logic: Only select when CPU is idle
-            if (runningProcess == nullptr && !readyList.empty()) {
-                 auto highestPriorityIt = std::min_element(readyList.begin(), readyList.end(), comparePriority);
-                 runningProcess = *highestPriorityIt;
-                 readyList.erase(highestPriorityIt);
-
-                 if (runningProcess->startTime == -1) {
-                     runningProcess->startTime = currentTime;
-                     runningProcess->responseTime = runningProcess->startTime - runningProcess->arrivalTime;
-                 }
-            }
-        }
+    int steal() override {
+        return schedule(NO_PROCESS, 0, false);
+    }
 
-        // Execute or handle idle time
-        if (runningProcess != nullptr) {
-            if (preemptive) {
-                currentTime++;
-                runningProcess->remainingBurstTime--;
-
-                if (runningProcess->remainingBurstTime == 0) {
-                    runningProcess->completionTime = currentTime;
-                    completedProcesses.push_back(*runningProcess);
-                    completedCount++;
-                    runningProcess = nullptr;
-                }
-            } else {
-                // Non-preemptive runs to completion
-                int timeToRun = runningProcess->burstTime;
-                currentTime += timeToRun;
-                runningProcess->remainingBurstTime = 0;
-                runningProcess->completionTime = currentTime;
-                completedProcesses.push_back(*runningProcess);
-                completedCount++;
-                runningProcess = nullptr;
-            }
-        } else {
-             // CPU is idle
-            if (processIdx < processes.size() || !readyList.empty()) {
-                 if(readyList.empty() && processIdx < processes.size()) {
-                    int idleStart = currentTime;
-                    currentTime = processes[processIdx].arrivalTime;
-                    totalIdleTime += (currentTime - idleStart);
-                } else {
-                     currentTime++; 
-                     totalIdleTime++;
-                }
-            } else {
-                break; // No more processes
-            }
-        }
+    std::unique_ptr<SchedulingPolicy> clone() const override {
+        return std::unique_ptr<SchedulingPolicy>(new RoundRobinPolicy(timeQuantum));
     }
 
-    calculateMetrics(result, completedProcesses, currentTime, totalIdleTime);
-    return result;
-}
+    std::unique_ptr<SchedulingPolicy> copy() const override {
+        return std::unique_ptr<SchedulingPolicy>(new RoundRobinPolicy(*this));
+    }
+
+private:
+    int timeQuantum;
+    SlotQueue readyQueue;
+};
 
 /**
  * Simulates the Round Robin (RR) scheduling algorithm.
@@ -444,281 +366,686 @@ SimulationResult runPriority(std::vector<Process> processes, bool preemptive) {
  * If not completed, it's preempted and placed at the end of the ready queue. 
  * Handles arrivals, execution in time slices, preemption, completion, and idle time.
  */
-SimulationResult runRoundRobin(std::vector<Process> processes, int timeQuantum) {
-    SimulationResult result("Round Robin (Quantum=" + std::to_string(timeQuantum) + ")");
-    std::vector<Process> completedProcesses;
-    completedProcesses.reserve(processes.size());
-    std::queue<Process*> readyQueue;
-    int currentTime = 0;
-    int totalIdleTime = 0;
-    size_t processIdx = 0;
-    int completedCount = 0;
-    int timeSliceCounter = 0; // Tracks time used in current quantum
-
-    std::sort(processes.begin(), processes.end(), [](const Process& a, const Process& b) {
-        if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
-        return a.id < b.id;
-    });
+SimulationResult runRoundRobin(const Workload& workload, int timeQuantum, const SimulationOptions& options) {
+    SimulationEngine engine(workload, options);
+    RoundRobinPolicy policy(timeQuantum);
+    return engine.run(policy, "Round Robin (Quantum=" + std::to_string(timeQuantum) + ")");
+}
+
+SimulationResult runRoundRobin(const std::vector<Process>& processes, int timeQuantum, const SimulationOptions& options) {
+    return runRoundRobin(Workload(processes), timeQuantum, options);
+}
+
+/** Load weight of each nice level from -20 to 19, as in Linux CFS: one level is about 10% of CPU time. */
+static const int CFS_NICE_TO_WEIGHT[40] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+     9548,  7620,  6100,  4904,  3906,
+     3121,  2501,  1991,  1586,  1277,
+     1024,   820,   655,   526,   423,
+      335,   272,   215,   172,   137,
+      110,    87,    70,    56,    45,
+       36,    29,    23,    18,    15
+};
+static const long long CFS_NICE_0_WEIGHT = 1024;
+static const long long CFS_VRUNTIME_SCALE = 1024; // vruntime is kept in 1/1024 time units to limit rounding
+
+/** The priority field is used as the nice value (lower is more important), clamped to [-20, 19]. */
+static int cfsWeight(int priority) {
+    return CFS_NICE_TO_WEIGHT[std::min(std::max(priority, -20), 19) + 20];
+}
 
-    Process* runningProcess = nullptr;
+/** Helper structure for CFS to store a process's virtual runtime and load weight, indexed by slot. */
+struct CfsProcessData {
+    long long vruntime;
+    int weight;
+
+CfsProcessData() :
+    vruntime(0), weight(0) {}
+};
 
-    while (completedCount < processes.size()) {
-        // Add newly arrived processes to the ready queue
-        while (processIdx < processes.size() && processes[processIdx].arrivalTime <= currentTime) {
-            readyQueue.push(&processes[processIdx]);
-            processIdx++;
+/**
+ * CFS-style fair scheduler. Runnable processes are kept in an indexed min-heap ordered by virtual runtime, the CPU
+ * time a process received divided by its weight, so pick-next takes the leftmost (smallest) entry in O(log n)
+ * without the per-insert node allocation of a tree.
+ * A dispatched process gets its weight's share of the scheduling period (the target latency, stretched to
+ * minGranularity per runnable process when there are many). When the slice ends it goes back into the tree.
+ * A new process starts at the tree's minimum vruntime and preempts the running process if that process is
+ * ahead by more than minGranularity of the newcomer's virtual time. A process waking from I/O keeps its own
+ * vruntime unless it fell behind min_vruntime while blocked, so sleeping earns no extra CPU time later.
+ * The policy is not told about completions directly: being called with no running process after it dispatched
+ * one means that process finished (or blocked on I/O).
+ */
+class CfsPolicy final : public SchedulingPolicy {
+public:
+    explicit CfsPolicy(const CfsParameters& parameters)
+        : parameters(parameters), current(NO_PROCESS), lastUpdate(0), minVruntime(0), totalWeight(0), nextSequence(0) {}
+
+    void reserveSlots(size_t count) override {
+        if (processData.size() < count) processData.resize(count);
+        runnable.reserve(count);
+    }
+
+    void admit(int slot, int currentTime) override {
+        updateCurrent(currentTime); // Bring min_vruntime up to date before placing the newcomer
+        if (slot == current) {
+            // The multi-CPU engine reuses a completed process's slot before the next decision. Its weight goes, but like
+            // on one CPU it still counted towards min_vruntime above, since the decision at this instant has not happened.
+            totalWeight -= processData[current].weight;
+            current = NO_PROCESS;
         }
+        CfsProcessData& data = processData[slot];
+        data.weight = cfsWeight(priority(slot));
+        data.vruntime = minVruntime;
+        totalWeight += data.weight;
+        enqueue(slot);
+    }
 
-        // If CPU is idle, get the next process from ready queue
-        if (runningProcess == nullptr && !readyQueue.empty()) {
-            runningProcess = readyQueue.front();
-            readyQueue.pop();
-            timeSliceCounter = 0; // Reset quantum timer
+    void wake(int slot, int currentTime) override {
+        updateCurrent(currentTime);
+        CfsProcessData& data = processData[slot];
+        data.vruntime = std::max(data.vruntime, minVruntime);
+        totalWeight += data.weight;
+        enqueue(slot);
+    }
 
-            if (runningProcess->startTime == -1) {
-                runningProcess->startTime = currentTime;
-                runningProcess->responseTime = runningProcess->startTime - runningProcess->arrivalTime;
-            }
+    int schedule(int running, int currentTime, bool sliceExpired) override {
+        updateCurrent(currentTime);
+        if (running == NO_PROCESS && current != NO_PROCESS) {
+            totalWeight -= processData[current].weight; // The process dispatched last has completed
+            current = NO_PROCESS;
+            updateMinVruntime();
         }
 
-        // Execute or handle idle time
-        if (runningProcess != nullptr) {
-            currentTime++;
-            runningProcess->remainingBurstTime--;
-            timeSliceCounter++;
-
-            // Check for completion
-            if (runningProcess->remainingBurstTime == 0) {
-                runningProcess->completionTime = currentTime;
-                completedProcesses.push_back(*runningProcess);
-                completedCount++;
-                runningProcess = nullptr; // CPU becomes free
-                timeSliceCounter = 0;
-            } 
-            // Check if time quantum expired
-            else if (timeSliceCounter == timeQuantum) {
-                // Add newly arrived processes that arrived during this time slice before putting the current process back
-                 while (processIdx < processes.size() && processes[processIdx].arrivalTime <= currentTime) {
-                    readyQueue.push(&processes[processIdx]);
-                    processIdx++;
-                }
-                // Put the current process back in the queue if it's not finished
-                 readyQueue.push(runningProcess);
-                 runningProcess = nullptr;
-                 timeSliceCounter = 0;
-            }
-        } else {
-            // CPU is idle
-            if (processIdx < processes.size() || !readyQueue.empty()) {
-                if (readyQueue.empty() && processIdx < processes.size()) {
-                     int idleStart = currentTime;
-                     currentTime = processes[processIdx].arrivalTime;
-                     totalIdleTime += (currentTime - idleStart);
-                 } else {
-                    currentTime++;
-                    totalIdleTime++;
-                 }
+        int next = running;
+        if (running == NO_PROCESS) {
+            next = popLeftmost();
+        } else if (!runnable.empty()) {
+            if (sliceExpired) {
+                enqueue(running);
+                next = popLeftmost();
             } else {
-                break; // No more processes
+                int leftmost = runnable.top();
+                long long granularity = virtualTime(parameters.minGranularity, processData[leftmost].weight);
+                if (processData[running].vruntime - processData[leftmost].vruntime > granularity) {
+                    enqueue(running); // Wakeup preemption
+                    next = popLeftmost();
+                }
             }
         }
+        current = next;
+        return next;
+    }
+
+    int sliceLength(int slot) const override {
+        long long runnableCount = static_cast<long long>(runnable.size()) + 1;
+        long long period = std::max<long long>(parameters.targetLatency, runnableCount * parameters.minGranularity);
+        long long slice = period * processData[slot].weight / std::max<long long>(totalWeight, 1);
+        return static_cast<int>(std::min<long long>(std::max<long long>(slice, 1), UNBOUNDED_SLICE));
+    }
+
+    int steal() override {
+        int slot = popLeftmost();
+        if (slot != NO_PROCESS) totalWeight -= processData[slot].weight;
+        return slot;
+    }
+
+    std::unique_ptr<SchedulingPolicy> clone() const override {
+        return std::unique_ptr<SchedulingPolicy>(new CfsPolicy(parameters));
+    }
+
+    std::unique_ptr<SchedulingPolicy> copy() const override {
+        return std::unique_ptr<SchedulingPolicy>(new CfsPolicy(*this));
+    }
+
+private:
+    struct RunnableKey {
+        long long vruntime;
+        long long sequence; // Equal vruntimes run in insertion order
+
+        bool operator<(const RunnableKey& other) const {
+            if (vruntime != other.vruntime) return vruntime < other.vruntime;
+            return sequence < other.sequence;
+        }
+    };
+
+    static long long virtualTime(long long time, int weight) {
+        return time * CFS_NICE_0_WEIGHT * CFS_VRUNTIME_SCALE / weight;
+    }
+
+    void enqueue(int slot) {
+        runnable.push(slot, RunnableKey{processData[slot].vruntime, nextSequence++});
+        statsReadyInsert();
+    }
+
+    int popLeftmost() {
+        if (runnable.empty()) return NO_PROCESS;
+        statsReadyRemove();
+        return runnable.pop();
+    }
+
+    /** Charges the time since the last update to the current process's vruntime. */
+    void updateCurrent(int now) {
+        if (current != NO_PROCESS) processData[current].vruntime += virtualTime(now - lastUpdate, processData[current].weight);
+        lastUpdate = now;
+        updateMinVruntime();
     }
 
-    calculateMetrics(result, completedProcesses, currentTime, totalIdleTime);
-    return result;
+    /** min_vruntime only moves forward, following the smaller of the current and the leftmost vruntime. */
+    void updateMinVruntime() {
+        long long candidate = std::numeric_limits<long long>::max();
+        if (current != NO_PROCESS) candidate = processData[current].vruntime;
+        if (!runnable.empty()) candidate = std::min(candidate, runnable.topKey().vruntime);
+        if (candidate != std::numeric_limits<long long>::max()) minVruntime = std::max(minVruntime, candidate);
+    }
+
+    CfsParameters parameters;
+    std::vector<CfsProcessData> processData; // Indexed by slot
+    IndexedMinHeap<RunnableKey> runnable;
+    int current;          // Process returned by the last decision
+    int lastUpdate;       // Time up to which the running process's vruntime is charged
+    long long minVruntime;
+    long long totalWeight; // Admitted and not yet completed (or stolen) processes, including the running one
+    long long nextSequence;
+};
+
+/**
+ * Simulates a CFS-style fair scheduler (see CfsPolicy).
+ * Each process's share of the CPU follows the load weight of its priority read as a nice value, and the runnable
+ * process with the smallest virtual runtime runs next, for a slice of the target latency proportional to its weight.
+ */
+SimulationResult runCFS(const Workload& workload, const CfsParameters& parameters, const SimulationOptions& options) {
+    parameters.validate();
+    SimulationEngine engine(workload, options);
+    CfsPolicy policy(parameters);
+    return engine.run(policy, parameters.describe());
+}
+
+SimulationResult runCFS(const std::vector<Process>& processes, const CfsParameters& parameters, const SimulationOptions& options) {
+    return runCFS(Workload(processes), parameters, options);
+}
+
+void CfsParameters::validate() const {
+    if (targetLatency < 1) throw std::runtime_error("The CFS target latency must be at least 1");
+    if (minGranularity < 1) throw std::runtime_error("The CFS minimum granularity must be at least 1");
 }
 
-/** Helper structure for MLFQ to store process pointer and its MLFQ state.*/
+std::string CfsParameters::describe() const {
+    return "CFS (Latency=" + std::to_string(targetLatency) + ", MinGran=" + std::to_string(minGranularity) + ")";
+}
+
+/** Helper structure for MLFQ to store a process's MLFQ state, indexed by slot.*/
 struct MlfqProcessData {
-    Process* p;
     int currentQueue;
-    int timeInCurrentQuantum; 
     int lastExecutionTime;
 
-MlfqProcessData(Process* proc) : 
-    p(proc), currentQueue(0), timeInCurrentQuantum(0), lastExecutionTime(proc->arrivalTime) {}
+MlfqProcessData() : 
+    currentQueue(0), lastExecutionTime(0) {}
 };
 
+/** Compile-time table of the level a process is demoted to when its quantum expires (the last level keeps it). */
+template <int Levels>
+constexpr std::array<int, Levels> makeDemotionTable() {
+    std::array<int, Levels> table{};
+    for (int level = 0; level < Levels; ++level) table[level] = (level + 1 < Levels) ? level + 1 : Levels - 1;
+    return table;
+}
+
+/** Compile-time table of the level an aged process is boosted to under the given rule. */
+template <int Levels, BoostRule Boost>
+constexpr std::array<int, Levels> makeBoostTable() {
+    std::array<int, Levels> table{};
+    for (int level = 0; level < Levels; ++level) table[level] = (Boost == BoostRule::OneLevel && level > 0) ? level - 1 : 0;
+    return table;
+}
+
 /**
- * Simulates the Multi-Level Feedback Queue (MLFQ) scheduling algorithm.
- * Implements a specific MLFQ configuration with 3 queues:
- * - Q0: RR with Quantum 8
- * - Q1: RR with Quantum 16
- * - Q2: FCFS
- * New processes enter Q0. Processes are demoted if they use their full quantum.
- * Higher priority queues are always processed first. 
- * Includes preemption based on arrivals in higher queues and an aging mechanism (priority boost to Q0 after 50 time units of waiting).
+ * MLFQ with a compile-time number of levels and boost rule; each level is RR (with its quantum) or FCFS.
+ * The level count, demotion targets and boost targets are constexpr, so the queue array is fixed-size and the
+ * level loops have constant bounds; per-level quanta are a table lookup (FCFS levels have an unbounded slice).
+ * Quantum expiry arrives as a SliceEnd event; the earliest aging deadline among the queue fronts is requested
+ * as an engine timer so that a decision point exists at exactly the time a queued process becomes eligible for a boost.
  */
-SimulationResult runMLFQ(std::vector<Process> processes) {
-    SimulationResult result("MLFQ (Q0:RR8, Q1:RR16, Q2:FCFS, Age:50)");
-    const int NUM_QUEUES = 3;
-    const int QUANTUM_Q0 = 8;
-    const int QUANTUM_Q1 = 16;
-    const int AGING_THRESHOLD = 50; 
-
-    std::vector<Process> completedProcesses;
-    completedProcesses.reserve(processes.size());
-    std::vector<std::queue<MlfqProcessData*>> readyQueues(NUM_QUEUES);
-    std::vector<MlfqProcessData> processDataStore;
-    processDataStore.reserve(processes.size());
-
-    int currentTime = 0;
-    int totalIdleTime = 0;
-    size_t processIdx = 0;
-    int completedCount = 0;
-
-    // Sort processes by arrival time initially
-    std::sort(processes.begin(), processes.end(), [](const Process& a, const Process& b) {
-        if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
-        return a.id < b.id;
-    });
+template <int Levels, BoostRule Boost>
+class MlfqPolicy final : public SchedulingPolicy {
+public:
+    static_assert(Levels >= 1 && Levels <= MlfqConfig::MAX_LEVELS, "Unsupported MLFQ level count");
+    static constexpr std::array<int, Levels> DEMOTE_TO = makeDemotionTable<Levels>();
+    static constexpr std::array<int, Levels> BOOST_TO = makeBoostTable<Levels, Boost>();
+
+    explicit MlfqPolicy(const MlfqConfig& config)
+        : agingThreshold(config.agingThreshold), nextAgingDeadline(NO_TIMER), newcomerLevel(Levels) {
+        for (int level = 0; level < Levels; ++level) {
+            levelQuantum[level] = (config.levels[level].policy == LevelPolicy::FCFS) ? UNBOUNDED_SLICE : config.levels[level].quantum;
+        }
+    }
 
-    // Create the storage for MLFQ data
-    for (size_t i = 0; i < processes.size(); ++i) {
-        processDataStore.emplace_back(&processes[i]);
+    MlfqPolicy(const std::array<int, Levels>& levelQuantum, int agingThreshold)
+        : levelQuantum(levelQuantum), agingThreshold(agingThreshold), nextAgingDeadline(NO_TIMER), newcomerLevel(Levels) {}
+
+    void reserveSlots(size_t count) override {
+        if (processDataStore.size() < count) processDataStore.resize(count);
+        readyQueues.reserve(count);
     }
 
-    MlfqProcessData* runningProcessData = nullptr;
+    void admit(int slot, int currentTime) override {
+        MlfqProcessData& data = processDataStore[slot];
+        data.currentQueue = 0;
+        data.lastExecutionTime = currentTime; // Reset on boost
+        readyQueues.push(slot, 0);
+        statsReadyInsert();
+        newcomerLevel = 0;
+    }
 
-    while (completedCount < processes.size()) {
-        // 1. Add newly arrived processes to the highest priority queue (Q0)
-        while (processIdx < processDataStore.size() && processDataStore[processIdx].p->arrivalTime <= currentTime) {
-             processDataStore[processIdx].currentQueue = 0;
-             processDataStore[processIdx].lastExecutionTime = currentTime; // Or arrivalTime, reset on boost
-             readyQueues[0].push(&processDataStore[processIdx]);
-             processIdx++;
-        }
+    /** A process back from I/O gave up the CPU before its quantum ran out, so it keeps its level. */
+    void wake(int slot, int currentTime) override {
+        MlfqProcessData& data = processDataStore[slot];
+        data.lastExecutionTime = currentTime;
+        readyQueues.push(slot, data.currentQueue);
+        statsReadyInsert();
+        newcomerLevel = std::min(newcomerLevel, data.currentQueue);
+    }
 
-        // 2. Priority Boost (Aging)
-        // Iterate through processes in lower queues (Q1, Q2) 
-        for (int qLevel = 1; qLevel < NUM_QUEUES; ++qLevel) {
-            int currentQueueSize = readyQueues[qLevel].size();
-            for(int i = 0; i < currentQueueSize; ++i) {
-                 MlfqProcessData* pData = readyQueues[qLevel].front();
-                 readyQueues[qLevel].pop();
-                 if (currentTime - pData->lastExecutionTime >= AGING_THRESHOLD) {
-                     pData->currentQueue = 0; // Boost to highest queue
-                     pData->timeInCurrentQuantum = 0;
-                     pData->lastExecutionTime = currentTime; // Reset timer on boost
-                     readyQueues[0].push(pData);
-                 } else {
-                     readyQueues[qLevel].push(pData); // Put back if not aged
-                 }
+    int schedule(int running, int currentTime, bool sliceExpired) override {
+        if (running != NO_PROCESS) {
+            MlfqProcessData& runningData = processDataStore[running];
+            if (runningData.currentQueue > newcomerLevel) {
+                // Preempted by a new arrival (or a wakeup) in a higher queue: put running process back in its queue
+                runningData.lastExecutionTime = currentTime;
+                readyQueues.push(running, runningData.currentQueue);
+                statsReadyInsert();
+                running = NO_PROCESS;
+            } else if (sliceExpired) {
+                // Demotion on quantum expiry
+                int nextQueue = DEMOTE_TO[runningData.currentQueue];
+                if (nextQueue != runningData.currentQueue) traceEvent(TraceEventType::Demotion, running, currentTime, nextQueue);
+                runningData.currentQueue = nextQueue;
+                runningData.lastExecutionTime = currentTime;
+                readyQueues.push(running, nextQueue);
+                statsReadyInsert();
+                running = NO_PROCESS;
             }
         }
-
-        // 3. Select process to run
-        if (runningProcessData == nullptr) {
-            for (int qLevel = 0; qLevel < NUM_QUEUES; ++qLevel) {
-                if (!readyQueues[qLevel].empty()) {
-                    runningProcessData = readyQueues[qLevel].front();
-                    readyQueues[qLevel].pop();
-                    runningProcessData->timeInCurrentQuantum = 0; // Reset quantum usage
-
-                    if (runningProcessData->p->startTime == -1) {
-                        runningProcessData->p->startTime = currentTime;
-                        runningProcessData->p->responseTime = runningProcessData->p->startTime - runningProcessData->p->arrivalTime;
-                    }
-                    break; // Found process, stop searching queues
+        newcomerLevel = Levels;
+
+        // Priority Boost (Aging)
+        // Every push into a lower queue stamps lastExecutionTime with the push time, so each lower queue is
+        // ordered by aging deadline: only the due prefix of each queue is boosted, in level order.
+        nextAgingDeadline = NO_TIMER;
+        if (Boost != BoostRule::None) {
+            statsReadyScan(Levels - 1);
+            for (int qLevel = 1; qLevel < Levels; ++qLevel) {
+                while (!readyQueues.empty(qLevel) && currentTime - processDataStore[readyQueues.front(qLevel)].lastExecutionTime >= agingThreshold) {
+                    int slot = readyQueues.pop(qLevel);
+                    MlfqProcessData& pData = processDataStore[slot];
+                    pData.currentQueue = BOOST_TO[qLevel];
+                    traceEvent(TraceEventType::Boost, slot, currentTime, BOOST_TO[qLevel]);
+                    pData.lastExecutionTime = currentTime; // Reset timer on boost
+                    readyQueues.push(slot, BOOST_TO[qLevel]);
+                    statsReadyRemove();
+                    statsReadyInsert();
+                }
+            }
+            // Only after every boost: with one-level boosts a level scanned while empty can receive a boosted process
+            for (int qLevel = 1; qLevel < Levels; ++qLevel) {
+                if (!readyQueues.empty(qLevel)) {
+                    nextAgingDeadline = std::min(nextAgingDeadline, processDataStore[readyQueues.front(qLevel)].lastExecutionTime + agingThreshold);
                 }
             }
         }
 
-        // 4. Execute or handle idle time
-        if (runningProcessData != nullptr) {
-            currentTime++;
-            runningProcessData->p->remainingBurstTime--;
-            runningProcessData->timeInCurrentQuantum++;
-            runningProcessData->lastExecutionTime = currentTime; // Update last run time
-
-            // Check for completion
-            if (runningProcessData->p->remainingBurstTime == 0) {
-                runningProcessData->p->completionTime = currentTime;
-                completedProcesses.push_back(*(runningProcessData->p));
-                completedCount++;
-                runningProcessData = nullptr; // CPU is free
-            } else {
-                 // Check for preemption due to new arrival in higher queue
-                bool preempted = false;
-                while (processIdx < processDataStore.size() && processDataStore[processIdx].p->arrivalTime <= currentTime) {
-                    processDataStore[processIdx].currentQueue = 0;
-                    processDataStore[processIdx].lastExecutionTime = currentTime;
-                    readyQueues[0].push(&processDataStore[processIdx]);
-                    processIdx++;
-                    if (runningProcessData->currentQueue > 0) { // Only preempt if new arrival is higher priority
-                        preempted = true;
-                    }
-                }
-                
-                if (preempted) {
-                    // Put running process back in its queue
-                    readyQueues[runningProcessData->currentQueue].push(runningProcessData);
-                    runningProcessData = nullptr; 
-                } else {
-                     // Check for demotion (quantum expiry)
-                     int currentQuantum = (runningProcessData->currentQueue == 0) ? QUANTUM_Q0 : ((runningProcessData->currentQueue == 1) ? QUANTUM_Q1 : -1); 
-                     // Q2 is FCFS, no quantum
-
-                     if (currentQuantum != -1 && runningProcessData->timeInCurrentQuantum == currentQuantum) {
-                         int nextQueue = std::min(runningProcessData->currentQueue + 1, NUM_QUEUES - 1);
-                         runningProcessData->currentQueue = nextQueue;
-                         runningProcessData->timeInCurrentQuantum = 0;
-                         readyQueues[nextQueue].push(runningProcessData);
-                         runningProcessData = nullptr; // Yield CPU
-                     } 
-                     // If Q2 (FCFS), just continue running until completion or higher arrival
-                }
+        if (running != NO_PROCESS) return running;
+
+        // Select process to run from the highest non-empty queue
+        for (int qLevel = 0; qLevel < Levels; ++qLevel) {
+            if (!readyQueues.empty(qLevel)) {
+                statsReadyRemove();
+                statsReadyScan(qLevel);
+                return readyQueues.pop(qLevel);
+            }
+        }
+        statsReadyScan(Levels);
+        return NO_PROCESS;
+    }
+
+    int sliceLength(int slot) const override {
+        return levelQuantum[processDataStore[slot].currentQueue];
+    }
+
+    int nextTimerTime() const override {
+        return nextAgingDeadline;
+    }
+
+    /** Takes the front of the highest non-empty queue; aging is left to the next regular decision point. */
+    int steal() override {
+        for (int qLevel = 0; qLevel < Levels; ++qLevel) {
+            if (!readyQueues.empty(qLevel)) {
+                statsReadyRemove();
+                statsReadyScan(qLevel);
+                return readyQueues.pop(qLevel);
             }
-        } else {
-            // CPU is idle
-             if (processIdx < processDataStore.size() || completedCount < processes.size()) {
-                 // Check if any ready queues have items. If yes, idle for 1 unit hoping something happens.
-                 bool anyReady = false;
-                 for(int q=0; q<NUM_QUEUES; ++q) if(!readyQueues[q].empty()) anyReady = true;
-
-                 if (anyReady) {
-                     currentTime++;
-                     totalIdleTime++;
-                 } else if (processIdx < processDataStore.size()) {
-                    // Advance time to next arrival
-                    int idleStart = currentTime;
-                    currentTime = processDataStore[processIdx].p->arrivalTime;
-                    totalIdleTime += (currentTime - idleStart);
-                 } else {
-                      // Should only happen if all processes completed? Let main loop handle termination.
-                       break; 
-                 }
-             } else {
-                 break; // No more processes to arrive or run
-             }
         }
+        statsReadyScan(Levels);
+        return NO_PROCESS;
+    }
+
+    std::unique_ptr<SchedulingPolicy> clone() const override {
+        return std::unique_ptr<SchedulingPolicy>(new MlfqPolicy(levelQuantum, agingThreshold));
+    }
+
+    std::unique_ptr<SchedulingPolicy> copy() const override {
+        return std::unique_ptr<SchedulingPolicy>(new MlfqPolicy(*this));
+    }
+
+private:
+    std::array<int, Levels> levelQuantum;
+    int agingThreshold;
+    std::vector<MlfqProcessData> processDataStore; // Indexed by slot
+    SlotQueues<Levels> readyQueues; // One FIFO per level
+    int nextAgingDeadline;
+    int newcomerLevel; // Highest level (lowest index) a process was admitted or woken into since the last decision, or Levels
+};
+
+/** Instantiates the MLFQ policy for a fixed level count, selecting the boost rule at compile time, and runs it with run(policy, name). */
+template <int Levels, typename Run>
+SimulationResult runMlfqWithLevels(const MlfqConfig& config, Run run) {
+    switch (config.boostRule) {
+        case BoostRule::None: {
+            MlfqPolicy<Levels, BoostRule::None> policy(config);
+            return run(policy, config.describe());
+        }
+        case BoostRule::OneLevel: {
+            MlfqPolicy<Levels, BoostRule::OneLevel> policy(config);
+            return run(policy, config.describe());
+        }
+        default: {
+            MlfqPolicy<Levels, BoostRule::ToTop> policy(config);
+            return run(policy, config.describe());
+        }
+    }
+}
+
+/** Validates the configuration and runs the compile-time specialized policy for its level count with run(policy, name). */
+template <typename Run>
+SimulationResult runMlfqPolicy(const MlfqConfig& config, Run run) {
+    config.validate();
+    switch (config.levels.size()) {
+        case 1: return runMlfqWithLevels<1>(config, run);
+        case 2: return runMlfqWithLevels<2>(config, run);
+        case 3: return runMlfqWithLevels<3>(config, run);
+        case 4: return runMlfqWithLevels<4>(config, run);
+        case 5: return runMlfqWithLevels<5>(config, run);
+        case 6: return runMlfqWithLevels<6>(config, run);
+        case 7: return runMlfqWithLevels<7>(config, run);
+        default: return runMlfqWithLevels<8>(config, run);
+    }
+}
+
+/**
+ * Simulates the Multi-Level Feedback Queue (MLFQ) scheduling algorithm for an arbitrary configuration.
+ * The runtime level count selects one of the compile-time specialized policies (1 to MlfqConfig::MAX_LEVELS levels).
+ * New processes enter Q0. RR levels demote a process that uses its full quantum; FCFS levels run it until completion.
+ * A process returning from I/O re-enters the level it left.
+ * Higher priority queues are always processed first, arrivals preempt a process running in a lower queue,
+ * and queued processes are boosted according to the configured aging rule.
+ */
+SimulationResult runMLFQ(const Workload& workload, const MlfqConfig& config, const SimulationOptions& options) {
+    SimulationEngine engine(workload, options);
+    return runMlfqPolicy(config, [&engine](auto& policy, const std::string& name) {
+        return engine.run(policy, name);
+    });
+}
+
+/**
+ * Simulates the Multi-Level Feedback Queue (MLFQ) scheduling algorithm.
+ * Implements an MLFQ configuration with 3 queues (defaults in parentheses):
+ * - Q0: RR with Quantum parameters.quantumQ0 (8)
+ * - Q1: RR with Quantum parameters.quantumQ1 (16)
+ * - Q2: FCFS
+ * New processes enter Q0. Processes are demoted if they use their full quantum.
+ * Higher priority queues are always processed first. 
+ * Includes preemption based on arrivals in higher queues and an aging mechanism (priority boost to Q0 after parameters.agingThreshold (50) time units of waiting).
+ */
+SimulationResult runMLFQ(const Workload& workload, const MlfqParameters& parameters, const SimulationOptions& options) {
+    return runMLFQ(workload, MlfqConfig::fromParameters(parameters), options);
+}
+
+SimulationResult runMLFQ(const std::vector<Process>& processes, const MlfqConfig& config, const SimulationOptions& options) {
+    return runMLFQ(Workload(processes), config, options);
+}
+
+SimulationResult runMLFQ(const std::vector<Process>& processes, const MlfqParameters& parameters, const SimulationOptions& options) {
+    return runMLFQ(Workload(processes), parameters, options);
+}
+
+/**
+ * Constructs the policy named by algorithm (fcfs, sjf, srtf, priority, priority-preemptive, rr, mlfq or cfs) and runs it
+ * with run(policy, name), using the same result names as the runX functions. Throws runtime error for an unknown name.
+ */
+template <typename Run>
+SimulationResult runNamedPolicy(const std::string& algorithm, int timeQuantum, const MlfqConfig& mlfqConfig,
+                                const CfsParameters& cfsParameters, Run run) {
+    if (algorithm == "fcfs") {
+        FcfsPolicy policy;
+        return run(policy, "FCFS");
+    } else if (algorithm == "sjf") {
+        SjfPolicy policy;
+        return run(policy, "SJF (Non-Preemptive)");
+    } else if (algorithm == "srtf") {
+        SrtfPolicy policy;
+        return run(policy, "SRTF (Preemptive SJF)");
+    } else if (algorithm == "priority" || algorithm == "priority-preemptive") {
+        bool preemptive = (algorithm == "priority-preemptive");
+        PriorityPolicy policy(preemptive);
+        return run(policy, preemptive ? "Priority (Preemptive)" : "Priority (Non-Preemptive)");
+    } else if (algorithm == "rr") {
+        RoundRobinPolicy policy(timeQuantum);
+        return run(policy, "Round Robin (Quantum=" + std::to_string(timeQuantum) + ")");
+    } else if (algorithm == "mlfq") {
+        return runMlfqPolicy(mlfqConfig, run);
+    } else if (algorithm == "cfs") {
+        cfsParameters.validate();
+        CfsPolicy policy(cfsParameters);
+        return run(policy, cfsParameters.describe());
+    }
+    throw std::runtime_error("Unknown algorithm: " + algorithm);
+}
+
+/**
+ * Streams a workload through a single algorithm on the StreamingSimulationEngine.
+ * The policies and result names are the same as the in-memory runX functions, so the final result matches
+ * running that function on the whole workload.
+ */
+SimulationResult runStreaming(ProcessStream& stream, const std::string& algorithm, int timeQuantum, const MlfqConfig& mlfqConfig,
+                              int snapshotInterval, const SnapshotCallback& onSnapshot, const CfsParameters& cfsParameters,
+                              const SimulationOptions& options) {
+    StreamingSimulationEngine engine(stream, snapshotInterval, onSnapshot, options);
+    return runNamedPolicy(algorithm, timeQuantum, mlfqConfig, cfsParameters, [&engine](SchedulingPolicy& policy, const std::string& name) {
+        return engine.run(policy, name);
+    });
+}
+
+/**
+ * Runs one algorithm on the MultiCoreSimulationEngine; the policy constructed here is the prototype cloned onto every CPU.
+ * The result name is the single-CPU name followed by the CPU count.
+ */
+SimulationResult runMultiCore(const Workload& workload, const std::string& algorithm, int timeQuantum, const MlfqConfig& mlfqConfig,
+                              const MultiCoreConfig& config, const CfsParameters& cfsParameters, const SimulationOptions& options) {
+    MultiCoreSimulationEngine engine(workload, config, options);
+    std::string suffix = " [" + std::to_string(config.cores) + (config.cores == 1 ? " CPU]" : " CPUs]");
+    return runNamedPolicy(algorithm, timeQuantum, mlfqConfig, cfsParameters, [&engine, &suffix](SchedulingPolicy& policy, const std::string& name) {
+        return engine.run(policy, name + suffix);
+    });
+}
+
+/**
+ * Builds a CheckpointedSimulation around the named policy, runs the baseline to collect its checkpoints and
+ * re-simulates every scenario from them; the baseline's checkpoints serve all scenarios.
+ */
+std::vector<WhatIfRun> runWhatIf(const Workload& baseline, const std::vector<WhatIfScenario>& scenarios, const std::string& algorithm,
+                                 int timeQuantum, const MlfqConfig& mlfqConfig, int checkpointInterval,
+                                 const CfsParameters& cfsParameters, const SimulationOptions& options) {
+    std::vector<WhatIfRun> runs;
+    runNamedPolicy(algorithm, timeQuantum, mlfqConfig, cfsParameters,
+                   [&](SchedulingPolicy& policy, const std::string& name) {
+        CheckpointedSimulation simulation(policy, name, checkpointInterval, options);
+        WhatIfRun base;
+        base.scenario = "baseline";
+        base.result = simulation.run(baseline);
+        base.simulatedEvents = base.result.eventCount;
+        runs.push_back(base);
+        for (const WhatIfScenario& scenario : scenarios) {
+            runs.push_back(simulation.rerun(scenario.workload));
+            runs.back().scenario = scenario.name;
+            runs.back().result.algorithmName = name + " / " + scenario.name;
+        }
+        return base.result;
+    });
+    return runs;
+}
+
+/**
+ * Prints one row per scenario run: where it resumed, how many events it simulated and how many a full run handles,
+ * and the percentage of those it skipped by resuming from a checkpoint.
+ */
+void printResimulation(const std::vector<WhatIfRun>& runs) {
+    size_t nameWidth = 45;
+    for (const auto& run : runs) nameWidth = std::max(nameWidth, run.result.algorithmName.size() + 1);
+
+    std::cout << "\n--- Incremental Re-simulation ---" << std::endl;
+    std::cout << std::left << std::setw(nameWidth) << "Algorithm / Scenario"
+              << std::setw(15) << "Resumed At"
+              << std::setw(18) << "Events Simulated"
+              << std::setw(18) << "Full Run Events"
+              << std::setw(15) << "Skipped (%)"
+              << std::endl;
+    std::cout << std::string(nameWidth + 66, '-') << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& run : runs) {
+        if (run.scenario == "baseline") continue;
+        long long total = run.result.eventCount;
+        std::cout << std::left << std::setw(nameWidth) << run.result.algorithmName
+                  << std::setw(15) << run.resumedFrom
+                  << std::setw(18) << run.simulatedEvents
+                  << std::setw(18) << total
+                  << std::setw(15) << (total > 0 ? static_cast<double>(total - run.simulatedEvents) / total * 100.0 : 0.0)
+                  << std::endl;
+    }
+    std::cout << "----------------------------" << std::endl;
+}
+
+/**
+ * Prints, for each result that did I/O, how many I/O bursts were served, how busy the devices were and how long
+ * processes queued for one, next to CPU utilization: CPU and device utilization adding up to more than 100% is
+ * the overlap of computation and I/O.
+ */
+void printIoSummary(const std::vector<SimulationResult>& results) {
+    size_t nameWidth = 45;
+    bool any = false;
+    for (const auto& result : results) {
+        nameWidth = std::max(nameWidth, result.algorithmName.size() + 1);
+        any = any || result.ioRequests > 0;
     }
+    if (!any) return;
 
-    calculateMetrics(result, completedProcesses, currentTime, totalIdleTime);
-    return result;
+    std::cout << "\n--- CPU and I/O ---" << std::endl;
+    std::cout << std::left << std::setw(nameWidth) << "Algorithm"
+              << std::setw(15) << "I/O Requests"
+              << std::setw(15) << "I/O Util (%)"
+              << std::setw(15) << "Avg I/O Wait"
+              << std::setw(15) << "CPU Util (%)"
+              << std::endl;
+    std::cout << std::string(nameWidth + 60, '-') << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& result : results) {
+        if (result.ioRequests == 0) continue;
+        std::cout << std::left << std::setw(nameWidth) << result.algorithmName
+                  << std::setw(15) << result.ioRequests
+                  << std::setw(15) << result.ioUtilization
+                  << std::setw(15) << static_cast<double>(result.ioWaitTime) / result.ioRequests
+                  << std::setw(15) << result.cpuUtilization
+                  << std::endl;
+    }
+    std::cout << "----------------------------" << std::endl;
+}
+
+/**
+ * Prints, for each multi-CPU result, the load imbalance, the number of migrations and the spread of CPU
+ * utilization, followed by the utilization of every CPU (eight per line). Single-CPU results are skipped.
+ */
+void printCoreUtilization(const std::vector<SimulationResult>& results) {
+    size_t nameWidth = 45;
+    bool any = false;
+    for (const auto& result : results) {
+        nameWidth = std::max(nameWidth, result.algorithmName.size() + 1);
+        any = any || !result.coreUtilization.empty();
+    }
+    if (!any) return;
+
+    std::cout << "\n--- Per-CPU Load ---" << std::endl;
+    std::cout << std::left << std::setw(nameWidth) << "Algorithm"
+              << std::setw(18) << "Imbalance (%)"
+              << std::setw(14) << "Migrations"
+              << std::setw(14) << "Min Util (%)"
+              << std::setw(14) << "Max Util (%)"
+              << std::endl;
+    std::cout << std::string(nameWidth + 60, '-') << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& result : results) {
+        if (result.coreUtilization.empty()) continue;
+        auto range = std::minmax_element(result.coreUtilization.begin(), result.coreUtilization.end());
+        std::cout << std::left << std::setw(nameWidth) << result.algorithmName
+                  << std::setw(18) << result.loadImbalance
+                  << std::setw(14) << result.migrations
+                  << std::setw(14) << *range.first
+                  << std::setw(14) << *range.second
+                  << std::endl;
+    }
+    std::cout << "----------------------------" << std::endl;
+
+    for (const auto& result : results) {
+        if (result.coreUtilization.empty()) continue;
+        std::cout << "\n" << result.algorithmName << " CPU utilization (%):" << std::endl;
+        for (size_t core = 0; core < result.coreUtilization.size(); ++core) {
+            std::cout << "  CPU" << std::left << std::setw(4) << core << std::right << std::setw(7) << result.coreUtilization[core];
+            if (core % 8 == 7 || core + 1 == result.coreUtilization.size()) std::cout << std::endl;
+        }
+        std::cout << std::left;
+    }
+}
+
+/** Formats a tail summary as "p50 / p90 / p99 / p99.9 / max" for one comparison table cell. */
+static std::string formatPercentiles(const LatencyPercentiles& p) {
+    return std::to_string(p.p50) + " / " + std::to_string(p.p90) + " / " + std::to_string(p.p99) + " / " +
+           std::to_string(p.p999) + " / " + std::to_string(p.max);
 }
 
 /**
  * Prints a formatted comparison table for multiple simulation results.
  * Takes a vector of SimulationResult objects and displays their key performance 
- * metrics side-by-side in a clearly formatted table for easy comparison.
+ * metrics side-by-side in a clearly formatted table for easy comparison, followed by a table of
+ * waiting, turnaround and response time percentiles and one of context switches and preemptions.
  */
 void printComparison(const std::vector<SimulationResult>& results) {
     if (results.empty()) return;
 
+    // Widen the name column only when a (configurable MLFQ) name would not fit
+    size_t nameWidth = 45;
+    for (const auto& result : results) nameWidth = std::max(nameWidth, result.algorithmName.size() + 1);
+
     std::cout << "\n--- Performance Comparison ---" << std::endl;
-    std::cout << std::left << std::setw(45) << "Algorithm" 
+    std::cout << std::left << std::setw(nameWidth) << "Algorithm" 
               << std::setw(15) << "Avg Waiting" 
               << std::setw(15) << "Avg Turnaround" 
               << std::setw(15) << "Avg Response"
               << std::setw(15) << "CPU Util (%)"
               << std::setw(25) << "Throughput (proc/unit)"
               << std::endl;
-    std::cout << std::string(130, '-') << std::endl;
+    std::cout << std::string(nameWidth + 85, '-') << std::endl;
 
     std::cout << std::fixed << std::setprecision(2);
     for (const auto& result : results) {
-        std::cout << std::left << std::setw(45) << result.algorithmName
+        std::cout << std::left << std::setw(nameWidth) << result.algorithmName
                   << std::setw(15) << result.averageWaitingTime
                   << std::setw(15) << result.averageTurnaroundTime
                   << std::setw(15) << result.averageResponseTime
@@ -727,4 +1054,39 @@ void printComparison(const std::vector<SimulationResult>& results) {
                   << std::endl;
     }
     std::cout << "----------------------------" << std::endl;
+
+    std::cout << "\n--- Tail Latency (p50 / p90 / p99 / p99.9 / max) ---" << std::endl;
+    std::cout << std::left << std::setw(nameWidth) << "Algorithm"
+              << std::setw(36) << "Waiting"
+              << std::setw(36) << "Turnaround"
+              << std::setw(36) << "Response"
+              << std::endl;
+    std::cout << std::string(nameWidth + 108, '-') << std::endl;
+    for (const auto& result : results) {
+        std::cout << std::left << std::setw(nameWidth) << result.algorithmName
+                  << std::setw(36) << formatPercentiles(result.waitingPercentiles)
+                  << std::setw(36) << formatPercentiles(result.turnaroundPercentiles)
+                  << std::setw(36) << formatPercentiles(result.responsePercentiles)
+                  << std::endl;
+    }
+    std::cout << "----------------------------" << std::endl;
+
+    std::cout << "\n--- Context Switches ---" << std::endl;
+    std::cout << std::left << std::setw(nameWidth) << "Algorithm"
+              << std::setw(15) << "Switches"
+              << std::setw(15) << "Preemptions"
+              << std::setw(15) << "Per Process"
+              << std::setw(15) << "Switch Time"
+              << std::endl;
+    std::cout << std::string(nameWidth + 60, '-') << std::endl;
+    for (const auto& result : results) {
+        double perProcess = result.totalProcessesCompleted > 0 ? static_cast<double>(result.contextSwitches) / result.totalProcessesCompleted : 0.0;
+        std::cout << std::left << std::setw(nameWidth) << result.algorithmName
+                  << std::setw(15) << result.contextSwitches
+                  << std::setw(15) << result.preemptions
+                  << std::setw(15) << perProcess
+                  << std::setw(15) << result.contextSwitchTime
+                  << std::endl;
+    }
+    std::cout << "----------------------------" << std::endl;
 } 
\ No newline at end of file
@@ -3,7 +3,16 @@
 
 #include <vector>
 #include <string>
+#include <functional>
 #include "Process.h"
+#include "Workload.h"
+#include "MlfqConfig.h"
+#include "LatencyHistogram.h"
+#include "EngineStats.h"
+
+class ProcessStream;
+struct MultiCoreConfig;
+class TraceRecorder;
 
 /** Holds the aggregated performance metrics resulting from a single CPU scheduling algorithm simulation run. */
 struct SimulationResult {
@@ -15,6 +24,22 @@ struct SimulationResult {
     double averageResponseTime;
     int totalElapsedTime;
     int totalProcessesCompleted;
+    long long eventCount; // Events handled by the engine, a measure of simulation work rather than a scheduling metric
+    LatencyPercentiles waitingPercentiles;
+    LatencyPercentiles turnaroundPercentiles;
+    LatencyPercentiles responsePercentiles;
+    std::vector<double> coreUtilization; // Busy percentage of each CPU in multi-CPU runs, empty on a single CPU
+    double loadImbalance;                // Multi-CPU: (busiest CPU's busy time / mean busy time - 1) * 100
+    long long migrations;                // Multi-CPU: processes moved to another CPU by work stealing
+    long long contextSwitches;           // Dispatches of a process other than the one that held the CPU before
+    long long preemptions;               // Times a process lost the CPU before finishing its burst
+    long long contextSwitchTime;         // Time spent switching (all CPUs); it counts as neither work nor idle time
+    long long ioRequests;                // I/O bursts served; 0 unless the workload does I/O
+    double ioUtilization;                // Busy percentage of the I/O devices (all devices together)
+    long long ioWaitTime;                // Time blocked processes spent queued for a free I/O device
+#ifdef SCHEDULER_STATS
+    EngineStats engineStats;             // Cost of the run itself, reported by --stats
+#endif
 
     SimulationResult(std::string name = "") : 
         algorithmName(name),
@@ -24,32 +49,182 @@ struct SimulationResult {
         throughput(0.0),
         averageResponseTime(0.0),
         totalElapsedTime(0),
-        totalProcessesCompleted(0) {}
+        totalProcessesCompleted(0),
+        eventCount(0),
+        loadImbalance(0.0),
+        migrations(0),
+        contextSwitches(0),
+        preemptions(0),
+        contextSwitchTime(0),
+        ioRequests(0),
+        ioUtilization(0.0),
+        ioWaitTime(0) {}
+};
+
+/** Tunables of the CFS-style fair scheduler, in simulation time units. */
+struct CfsParameters {
+    int targetLatency;  // Period in which every runnable process should run once
+    int minGranularity; // Smallest slice before the period is stretched; also the wakeup preemption threshold
+
+    CfsParameters(int latency = 24, int granularity = 3) :
+        targetLatency(latency),
+        minGranularity(granularity) {}
+
+    /** Throws runtime error unless both values are positive. */
+    void validate() const;
+
+    /** Name used in result tables, e.g. "CFS (Latency=24, MinGran=3)". */
+    std::string describe() const;
+};
+
+/**
+ * Time a CPU spends on a context switch before the dispatched process starts running.
+ * The cost depends on how the previous process left the CPU, so preemption can be made dearer than a voluntary switch.
+ */
+struct ContextSwitchCost {
+    int voluntary = 0;  // After the previous process completed, or from an idle CPU
+    int preemption = 0; // After the previous process was preempted (slice expiry or a more urgent process)
+
+    /** Throws runtime error if either cost is negative. */
+    void validate() const;
+};
+
+/** Engine settings shared by every runX function; the defaults reproduce a plain, untraced run. */
+struct SimulationOptions {
+    ContextSwitchCost contextSwitch;
+    TraceRecorder* trace = nullptr; // Records the run's scheduling events when set (see TraceRecorder.h)
+    int ioDevices = 1;              // Identical I/O devices serving blocked processes from one FIFO queue
+
+    /** Throws runtime error for an invalid context-switch cost or fewer than one I/O device. */
+    void validate() const;
 };
 
+/**
+ * Running totals and latency histograms of the per-process metrics, updated as each process completes.
+ * fill() produces the averages, percentiles, CPU utilization and throughput of the processes recorded so far, without keeping them.
+ */
+struct OnlineMetrics {
+    double totalWaitingTime = 0;
+    double totalTurnaroundTime = 0;
+    double totalResponseTime = 0;
+    int validResponseTimes = 0;
+    int completed = 0;
+    LatencyHistogram waitingTimes;
+    LatencyHistogram turnaroundTimes;
+    LatencyHistogram responseTimes;
+
+    /** Adds a completed process (state.completionTime set) to the totals. */
+    void record(int arrivalTime, int burstTime, const ProcessState& state);
+
+    /** Adds one process's final times; responseTime is -1 if the process never started. */
+    void recordTimes(int waitingTime, int turnaroundTime, int responseTime);
+
+    /**
+     * Writes the metrics for a run that has reached currentTime with totalIdleTime idle units and contextSwitchTime
+     * units spent switching; neither counts as busy time for CPU utilization.
+     */
+    void fill(SimulationResult& result, int currentTime, int totalIdleTime, long long contextSwitchTime = 0) const;
+};
+
+/** Receives interim metrics while a streaming simulation is running. */
+typedef std::function<void(const SimulationResult&)> SnapshotCallback;
+
+/*
+ * Each runX function has two forms. The Workload form runs over a shared, already sorted workload and only
+ * allocates the per-run state, so one Workload can serve many runs (including concurrent ones). The vector
+ * form builds a temporary Workload first and is convenient for one-off runs. SimulationOptions add context-switch
+ * costs and tracing; the defaults run without either.
+ */
+
 /** Runs the First-Come, First-Served scheduling algorithm simulation. */
-SimulationResult runFCFS(std::vector<Process> processes);
+SimulationResult runFCFS(const Workload& workload, const SimulationOptions& options = SimulationOptions());
+SimulationResult runFCFS(const std::vector<Process>& processes, const SimulationOptions& options = SimulationOptions());
 
 /** Runs the non-preemptive Shortest Job First scheduling algorithm simulation. */
-SimulationResult runSJF(std::vector<Process> processes); 
+SimulationResult runSJF(const Workload& workload, const SimulationOptions& options = SimulationOptions());
+SimulationResult runSJF(const std::vector<Process>& processes, const SimulationOptions& options = SimulationOptions());
 
 /** Runs the preemptive Shortest Remaining Time First scheduling algorithm simulation. */
-SimulationResult runSRTF(std::vector<Process> processes); 
+SimulationResult runSRTF(const Workload& workload, const SimulationOptions& options = SimulationOptions());
+SimulationResult runSRTF(const std::vector<Process>& processes, const SimulationOptions& options = SimulationOptions());
 
 /** Runs the Priority scheduling algorithm simulation (preemptive or non-preemptive). */
-SimulationResult runPriority(std::vector<Process> processes, bool preemptive); 
+SimulationResult runPriority(const Workload& workload, bool preemptive, const SimulationOptions& options = SimulationOptions());
+SimulationResult runPriority(const std::vector<Process>& processes, bool preemptive, const SimulationOptions& options = SimulationOptions());
 
 /** Runs the Round Robin scheduling algorithm simulation with a specified time quantum. */
-SimulationResult runRoundRobin(std::vector<Process> processes, int timeQuantum);
+SimulationResult runRoundRobin(const Workload& workload, int timeQuantum, const SimulationOptions& options = SimulationOptions());
+SimulationResult runRoundRobin(const std::vector<Process>& processes, int timeQuantum, const SimulationOptions& options = SimulationOptions());
+
+/** Runs the CFS-style fair scheduling simulation, with weights derived from the priority field (read as a nice value). */
+SimulationResult runCFS(const Workload& workload, const CfsParameters& parameters = CfsParameters(), const SimulationOptions& options = SimulationOptions());
+SimulationResult runCFS(const std::vector<Process>& processes, const CfsParameters& parameters = CfsParameters(), const SimulationOptions& options = SimulationOptions());
 
 /** Runs the Multi-Level Feedback Queue scheduling algorithm simulation. */
-SimulationResult runMLFQ(std::vector<Process> processes); 
+SimulationResult runMLFQ(const Workload& workload, const MlfqParameters& parameters = MlfqParameters(), const SimulationOptions& options = SimulationOptions());
+SimulationResult runMLFQ(const std::vector<Process>& processes, const MlfqParameters& parameters = MlfqParameters(), const SimulationOptions& options = SimulationOptions());
+
+/** Runs a Multi-Level Feedback Queue simulation with a custom level layout and boost rule. */
+SimulationResult runMLFQ(const Workload& workload, const MlfqConfig& config, const SimulationOptions& options = SimulationOptions());
+SimulationResult runMLFQ(const std::vector<Process>& processes, const MlfqConfig& config, const SimulationOptions& options = SimulationOptions());
+
+/**
+ * Runs one algorithm over an arrival-ordered process stream in memory bounded by the in-flight processes.
+ * algorithm is one of fcfs, sjf, srtf, priority, priority-preemptive, rr, mlfq or cfs (rr and mlfq use timeQuantum
+ * and mlfqConfig respectively, cfs uses cfsParameters). With a positive snapshotInterval, onSnapshot is called
+ * with interim metrics every snapshotInterval simulated time units. Throws runtime error for an unknown algorithm or a malformed stream.
+ */
+SimulationResult runStreaming(ProcessStream& stream, const std::string& algorithm, int timeQuantum, const MlfqConfig& mlfqConfig,
+                              int snapshotInterval = 0, const SnapshotCallback& onSnapshot = nullptr,
+                              const CfsParameters& cfsParameters = CfsParameters(), const SimulationOptions& options = SimulationOptions());
+
+/**
+ * Runs one algorithm (named as for runStreaming) on several simulated CPUs, each with its own ready queue,
+ * with idle CPUs stealing work from the most loaded one. The result adds per-CPU utilization, load imbalance
+ * and the number of migrations. Throws runtime error for an unknown algorithm or an invalid config.
+ */
+SimulationResult runMultiCore(const Workload& workload, const std::string& algorithm, int timeQuantum, const MlfqConfig& mlfqConfig,
+                              const MultiCoreConfig& config, const CfsParameters& cfsParameters = CfsParameters(),
+                              const SimulationOptions& options = SimulationOptions());
+
+/** An edited copy of a workload to compare against the original, e.g. with one process arriving later. */
+struct WhatIfScenario {
+    std::string name;
+    Workload workload;
+};
+
+/** One run of a what-if comparison and how much of it had to be simulated again. */
+struct WhatIfRun {
+    std::string scenario;              // "baseline" or the scenario's name
+    SimulationResult result;           // Equal to a full run of the scenario's workload
+    int resumedFrom = 0;               // Time of the checkpoint the run resumed from; 0 if it started from the beginning
+    long long simulatedEvents = 0;     // Events this run handled itself; result.eventCount also counts those before the checkpoint
+};
+
+/**
+ * Runs one algorithm (named as for runStreaming) on a single CPU over baseline, keeping a checkpoint every
+ * checkpointInterval time units, and then re-simulates each scenario from the last checkpoint before its earliest
+ * change (see CheckpointedSimulation). Returns the baseline run followed by one run per scenario; scenario results are
+ * named "<algorithm> / <scenario>". Throws runtime error for an unknown algorithm, an interval below 1 or a traced run.
+ */
+std::vector<WhatIfRun> runWhatIf(const Workload& baseline, const std::vector<WhatIfScenario>& scenarios, const std::string& algorithm,
+                                 int timeQuantum, const MlfqConfig& mlfqConfig, int checkpointInterval,
+                                 const CfsParameters& cfsParameters = CfsParameters(), const SimulationOptions& options = SimulationOptions());
 
 /** Prints the detailed performance metrics for a single simulation result. */
 void printResults(const SimulationResult& result);
 
-/** Prints a formatted comparison table of performance metrics for multiple simulation results. */
+/** Prints formatted comparison tables of the performance metrics, tail latencies and context switches of multiple results. */
 void printComparison(const std::vector<SimulationResult>& results);
 
+/** Prints I/O requests, device utilization and queueing next to CPU utilization; prints nothing if no run did I/O. */
+void printIoSummary(const std::vector<SimulationResult>& results);
+
+/** Prints, for every scenario run, the checkpoint it resumed from and the share of the full run's events it skipped. */
+void printResimulation(const std::vector<WhatIfRun>& runs);
+
+/** Prints load imbalance, migrations and per-CPU utilization of the multi-CPU results; prints nothing if there are none. */
+void printCoreUtilization(const std::vector<SimulationResult>& results);
+
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,101 @@
+#ifndef SCHEDULING_POLICY_H
+#define SCHEDULING_POLICY_H
+
+#include <vector>
+#include <limits>
+#include <memory>
+#include "Workload.h"
+#include "TraceRecorder.h"
+
+/**
+ * Interface implemented by every scheduling policy that runs on the SimulationEngine.
+ * The engine owns the clock, arrivals, completions and idle accounting; a policy only owns its
+ * ready structure and decides which process holds the CPU at each decision point.
+ * Processes are identified by slot: an index into the workload columns and the run's ProcessState arena.
+ * SimulationEngine::run is instantiated for the policy's own type, so declaring a policy class final removes the
+ * virtual calls from its single-CPU runs.
+ */
+class SchedulingPolicy {
+public:
+    static const int UNBOUNDED_SLICE = std::numeric_limits<int>::max();
+    static const int NO_TIMER = std::numeric_limits<int>::max();
+    static const int NO_PROCESS = -1;
+
+    SchedulingPolicy() : workload(nullptr), states(nullptr), recorder(nullptr), core(0) {}
+    virtual ~SchedulingPolicy() {}
+
+    /**
+     * Gives the policy read access to the process columns and run state; called by the engine before the first admit.
+     * Policy-internal events (such as MLFQ demotions) go to trace, if any, tagged with the policy's CPU.
+     */
+    void attach(const Workload& processes, const std::vector<ProcessState>& runState, TraceRecorder* trace = nullptr, int cpu = 0) {
+        workload = &processes;
+        states = &runState;
+        recorder = trace;
+        core = cpu;
+    }
+
+    /**
+     * Makes room for per-process state in slots [0, count). Every admitted process carries a slot below the
+     * last reserved count; the engine only grows it, and a slot is reused only after its process completed.
+     */
+    virtual void reserveSlots(size_t /*count*/) {}
+
+    /** Adds a newly arrived process to the ready structure. */
+    virtual void admit(int slot, int currentTime) = 0;
+
+    /**
+     * Returns a process to the ready structure once its I/O burst is done; its remaining time is already its next
+     * CPU burst. The process left the CPU as if it had completed, so policies that keep per-process history
+     * (MLFQ levels, CFS vruntime) override this to resume from it instead of treating the process as new.
+     */
+    virtual void wake(int slot, int currentTime) { admit(slot, currentTime); }
+
+    /**
+     * Called once all events at currentTime have been applied.
+     * Returns the process that should hold the CPU: the running process to let it continue, another
+     * process to switch (the policy is responsible for requeueing the previous one), or NO_PROCESS to idle.
+     * sliceExpired is true when the running process reached the end of the slice given by sliceLength.
+     */
+    virtual int schedule(int running, int currentTime, bool sliceExpired) = 0;
+
+    /** Number of time units a freshly dispatched process may run before a SliceEnd event is raised. */
+    virtual int sliceLength(int /*slot*/) const { return UNBOUNDED_SLICE; }
+
+    /** Earliest future time at which the policy needs a decision point without any other event (e.g. aging). */
+    virtual int nextTimerTime() const { return NO_TIMER; }
+
+    /**
+     * Removes a ready (not running) process so that another CPU can run it, or returns NO_PROCESS if none is ready.
+     * Policies give up the process they would dispatch next, so the longest-waiting or most urgent work moves first.
+     */
+    virtual int steal() = 0;
+
+    /** A fresh, empty policy with the same configuration; the multi-CPU engine clones one per core. */
+    virtual std::unique_ptr<SchedulingPolicy> clone() const = 0;
+
+    /**
+     * A copy of this policy in its current state, ready structure and per-process data included, from which a
+     * checkpointed run can be resumed. The copy has to be attached again before use.
+     */
+    virtual std::unique_ptr<SchedulingPolicy> copy() const = 0;
+
+protected:
+    int arrivalTime(int slot) const { return workload->arrivalTimes[slot]; }
+    int burstTime(int slot) const { return workload->burstTimes[slot]; }
+    int priority(int slot) const { return workload->priorities[slot]; }
+    int remainingBurstTime(int slot) const { return (*states)[slot].remainingBurstTime; }
+
+    /** Records a policy-internal event for the process in slot when the run is traced. */
+    void traceEvent(TraceEventType type, int slot, int currentTime, int detail) const {
+        if (recorder) recorder->record(type, currentTime, workload->ids[slot], core, detail);
+    }
+
+private:
+    const Workload* workload;
+    const std::vector<ProcessState>* states;
+    TraceRecorder* recorder;
+    int core;
+};
+
+#endif
@@ -0,0 +1,512 @@
+#include "SimulationEngine.h"
+#include "EventQueue.h"
+#include "IndexedHeap.h"
+#include "WorkloadLoader.h"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * Arrival source over a ProcessStream.
+ * All processes sharing the next arrival time are read as one group and handed out in ID order. Admitted
+ * processes are stored in the slot columns and a completed process's slot is reused by a later arrival.
+ */
+class StreamArrivals {
+public:
+    explicit StreamArrivals(ProcessStream& stream) : stream(stream), lookahead(0, 0, 0, 0), groupIdx(0), slots(0), admitted(0) {
+        hasLookahead = stream.next(lookahead);
+        refill();
+    }
+
+    bool exhausted() const { return groupIdx == group.size(); }
+    int nextArrival() const { return group[groupIdx].arrivalTime; }
+
+    int admitNext() {
+        int slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<int>(slots++);
+            runState.emplace_back();
+        }
+        inFlight.store(slot, group[groupIdx]);
+        runState[slot] = ProcessState(group[groupIdx].burstTime);
+        if (!group[groupIdx].ioCpuBursts.empty() || slotBursts.size() > static_cast<size_t>(slot)) {
+            if (slotBursts.size() <= static_cast<size_t>(slot)) slotBursts.resize(slot + 1);
+            slotBursts[slot] = group[groupIdx].ioCpuBursts; // Reuses the slot's capacity
+        }
+        if (++groupIdx == group.size()) refill();
+        admitted++;
+        return slot;
+    }
+
+    void release(int slot) { freeSlots.push_back(slot); }
+    size_t slotCount() const { return slots; }
+    size_t admittedCount() const { return admitted; }
+    int burstCount(int slot) const { return static_cast<size_t>(slot) < slotBursts.size() ? static_cast<int>(slotBursts[slot].size()) : 0; }
+    const int* burstSequence(int slot) const { return slotBursts[slot].data(); }
+    const Workload& workload() const { return inFlight; }
+    std::vector<ProcessState>& states() { return runState; }
+
+private:
+    void refill() {
+        group.clear();
+        groupIdx = 0;
+        if (!hasLookahead) return;
+        int arrival = lookahead.arrivalTime;
+        while (hasLookahead && lookahead.arrivalTime == arrival) {
+            group.push_back(lookahead);
+            hasLookahead = stream.next(lookahead);
+        }
+        std::stable_sort(group.begin(), group.end(), [](const Process& a, const Process& b) { return a.id < b.id; });
+    }
+
+    ProcessStream& stream;
+    Process lookahead;
+    bool hasLookahead;
+    std::vector<Process> group;  // Processes sharing the next arrival time, in ID order
+    size_t groupIdx;             // Next process of group to admit
+    size_t slots;
+    size_t admitted;
+    Workload inFlight;           // Columns of the admitted processes, by slot
+    std::vector<ProcessState> runState;
+    std::vector<int> freeSlots;
+    std::vector<std::vector<int>> slotBursts; // I/O and CPU bursts of the admitted processes, by slot; empty until one does I/O
+};
+
+SimulationEngine::SimulationEngine(const Workload& workload, const SimulationOptions& options) : workload(workload), options(options) {
+    options.validate();
+}
+
+StreamingSimulationEngine::StreamingSimulationEngine(ProcessStream& stream, int snapshotInterval, SnapshotCallback onSnapshot,
+                                                     const SimulationOptions& options)
+    : stream(stream), snapshotInterval(snapshotInterval), onSnapshot(onSnapshot), options(options), peakSlots(0) {
+    options.validate();
+}
+
+SimulationResult StreamingSimulationEngine::run(SchedulingPolicy& policy, const std::string& algorithmName) {
+    StreamArrivals arrivals(stream);
+    SimulationResult result = runEventLoop(arrivals, policy, algorithmName, snapshotInterval, onSnapshot, options);
+    peakSlots = arrivals.slotCount();
+    return result;
+}
+
+/**
+ * Earliest arrival time at which two workloads differ: every process arriving before it has the same slot, ID, times,
+ * priority and bursts in both. NO_CHECKPOINT if the workloads are identical.
+ */
+static int firstDifference(const Workload& a, const Workload& b) {
+    size_t common = std::min(a.size(), b.size());
+    for (size_t slot = 0; slot < common; ++slot) {
+        int bursts = a.burstCount(slot);
+        bool same = a.ids[slot] == b.ids[slot] && a.arrivalTimes[slot] == b.arrivalTimes[slot] && a.burstTimes[slot] == b.burstTimes[slot] &&
+                    a.priorities[slot] == b.priorities[slot] && bursts == b.burstCount(slot) &&
+                    (bursts == 0 || std::equal(a.burstSequence(slot), a.burstSequence(slot) + bursts, b.burstSequence(slot)));
+        if (!same) return std::min(a.arrivalTimes[slot], b.arrivalTimes[slot]);
+    }
+    if (a.size() > common) return a.arrivalTimes[common];
+    if (b.size() > common) return b.arrivalTimes[common];
+    return NO_CHECKPOINT;
+}
+
+CheckpointedSimulation::CheckpointedSimulation(const SchedulingPolicy& prototype, const std::string& algorithmName, int checkpointInterval,
+                                               const SimulationOptions& options)
+    : prototype(prototype.clone()), algorithmName(algorithmName), checkpointInterval(checkpointInterval), options(options), baseline(nullptr) {
+    options.validate();
+    if (checkpointInterval < 1) throw std::runtime_error("The checkpoint interval must be at least 1");
+    if (options.trace != nullptr) throw std::runtime_error("Checkpointed runs cannot be traced");
+}
+
+CheckpointedSimulation::~CheckpointedSimulation() {}
+
+size_t CheckpointedSimulation::checkpointCount() const {
+    return checkpoints.size();
+}
+
+SimulationResult CheckpointedSimulation::run(const Workload& workload) {
+    checkpoints.clear();
+    baseline = &workload;
+    WorkloadArrivals arrivals(workload);
+    std::unique_ptr<SchedulingPolicy> policy = prototype->clone();
+    return runEventLoop<WorkloadArrivals, SchedulingPolicy, true>(arrivals, *policy, algorithmName, 0, nullptr, options, nullptr, &checkpoints, checkpointInterval);
+}
+
+WhatIfRun CheckpointedSimulation::rerun(const Workload& edited) const {
+    if (baseline == nullptr) throw std::runtime_error("A checkpointed simulation must run its baseline before any rerun");
+    int changedAt = firstDifference(*baseline, edited);
+    auto after = std::upper_bound(checkpoints.begin(), checkpoints.end(), changedAt,
+                                  [](int time, const SimulationCheckpoint& checkpoint) { return time < checkpoint.time; });
+
+    WhatIfRun run;
+    if (after == checkpoints.begin()) {
+        WorkloadArrivals arrivals(edited);
+        std::unique_ptr<SchedulingPolicy> policy = prototype->clone();
+        run.result = runEventLoop<WorkloadArrivals, SchedulingPolicy, true>(arrivals, *policy, algorithmName, 0, nullptr, options);
+        run.simulatedEvents = run.result.eventCount;
+        return run;
+    }
+    const SimulationCheckpoint& checkpoint = *(after - 1);
+    WorkloadArrivals arrivals(edited, checkpoint.states);
+    std::unique_ptr<SchedulingPolicy> policy = checkpoint.policy->copy();
+    run.result = runEventLoop<WorkloadArrivals, SchedulingPolicy, true>(arrivals, *policy, algorithmName, 0, nullptr, options, &checkpoint);
+    run.resumedFrom = checkpoint.time;
+    run.simulatedEvents = run.result.eventCount - checkpoint.eventCount;
+    return run;
+}
+
+void MultiCoreConfig::validate() const {
+    if (cores < 1) throw std::runtime_error("The number of CPUs must be at least 1");
+    if (migrationCost < 0) throw std::runtime_error("The migration cost must not be negative");
+}
+
+/** One simulated CPU: its policy, the processes it holds (by core-local slot) and its dispatch state. */
+struct Core {
+    std::unique_ptr<SchedulingPolicy> policy;
+    Workload processes;                 // Columns of the processes held by this CPU, by local slot
+    std::vector<ProcessState> states;
+    std::vector<IoProgress> io;         // By local slot, only when the workload does I/O
+    std::vector<int> freeSlots;
+    size_t reservedSlots = 0;
+    int load = 0;                       // Processes held, running or ready
+    int running = SchedulingPolicy::NO_PROCESS;
+    int dispatchId = 0;
+    bool sliceExpired = false;
+    int pendingTimer = SchedulingPolicy::NO_TIMER;
+    int accountedUntil = 0;             // Time up to which run time has been charged to the running process
+    int switchUntil = 0;                // End of the context switch into the running process
+    long long busyTime = 0;
+    long long switchTime = 0;
+    bool decisionPending = false;
+    bool listedIdle = false;
+
+    /** Returns a free local slot, growing the slot table (and the policy's per-slot state) when needed. */
+    int allocate() {
+        int slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<int>(states.size());
+            states.emplace_back();
+        }
+        if (states.size() > reservedSlots) {
+            reservedSlots = std::max(states.size(), reservedSlots * 2);
+            policy->reserveSlots(reservedSlots);
+        }
+        return slot;
+    }
+
+    /**
+     * Charges the time since the last update to the context switch in progress and then to the running process;
+     * cores are only brought up to date when touched.
+     */
+    void advance(int now) {
+        if (running != SchedulingPolicy::NO_PROCESS) {
+            int switching = switchOverlap(accountedUntil, now, switchUntil);
+            switchTime += switching;
+            states[running].remainingBurstTime -= now - accountedUntil - switching;
+            busyTime += now - accountedUntil - switching;
+        }
+        accountedUntil = now;
+    }
+};
+
+MultiCoreSimulationEngine::MultiCoreSimulationEngine(const Workload& workload, const MultiCoreConfig& config, const SimulationOptions& options)
+    : workload(workload), config(config), options(options) {
+    config.validate();
+    options.validate();
+}
+
+/**
+ * Same event rules as runEventLoop, with Completion, SliceEnd and Timer events addressed to one CPU.
+ * Only the CPUs touched at an instant make a decision, after every event at that instant has been applied.
+ * Arrivals are placed after that instant's completions, so a CPU freed at the same time can take them directly.
+ * Context switches are charged per CPU exactly as in runEventLoop.
+ * A process blocked on I/O keeps its slot on its CPU but does not count towards that CPU's load; it wakes up on the
+ * same CPU after the instant's arrivals were placed (the order runEventLoop admits them in), and an idle CPU
+ * can then steal it like any other ready process.
+ */
+SimulationResult MultiCoreSimulationEngine::run(const SchedulingPolicy& prototype, const std::string& algorithmName) {
+    const int NO_PROCESS = SchedulingPolicy::NO_PROCESS;
+    EngineStatsScope statsScope;
+    SimulationResult result(algorithmName);
+    OnlineMetrics metrics;
+    EventQueue events;
+    int currentTime = 0;
+    long long eventCount = 0;
+    long long migrations = 0;
+    long long contextSwitches = 0;
+    long long preemptions = 0;
+    TraceRecorder* trace = options.trace;
+    size_t nextArrival = 0;
+    size_t inFlight = 0;
+    int nextCore = 0;                       // Round-robin placement when no CPU is idle
+    bool hasIo = workload.hasIo();
+    IoDevices devices(options.ioDevices);
+
+    std::vector<Core> cores(config.cores);
+    std::vector<int> idleCores;             // CPUs that held no process when listed, lowest index on top; may be stale
+    for (int c = config.cores - 1; c >= 0; --c) {
+        cores[c].policy = prototype.clone();
+        cores[c].policy->attach(cores[c].processes, cores[c].states, trace, c);
+        cores[c].listedIdle = true;
+        idleCores.push_back(c);
+    }
+    IndexedMinHeap<ReadyKey> backlog(config.cores); // CPUs with ready processes, keyed on (-ready count, CPU)
+    std::vector<int> touched;               // CPUs that need a decision at the current instant, in touch order
+    std::vector<size_t> arrived;            // Workload indices arriving at the current instant
+    std::vector<IoRequest> woken;           // I/O bursts finished at the current instant
+
+    auto isStale = [&](const Event& e) {
+        return (e.type == EventType::Completion || e.type == EventType::SliceEnd) &&
+               (cores[e.core].running == NO_PROCESS || e.dispatchId != cores[e.core].dispatchId);
+    };
+
+    auto touch = [&](int c) {
+        cores[c].advance(currentTime);
+        if (!cores[c].decisionPending) {
+            cores[c].decisionPending = true;
+            touched.push_back(c);
+        }
+    };
+
+    auto listIfIdle = [&](int c) {
+        if (cores[c].load == 0 && !cores[c].listedIdle) {
+            cores[c].listedIdle = true;
+            idleCores.push_back(c);
+        }
+    };
+
+    auto updateBacklog = [&](int c) {
+        int ready = cores[c].load - (cores[c].running != NO_PROCESS ? 1 : 0);
+        if (backlog.contains(c)) {
+            if (backlog.key(c).primary == -ready) return;
+            backlog.erase(c);
+        }
+        if (ready > 0) backlog.push(c, ReadyKey{-ready, c, 0});
+    };
+
+    /** Pops the lowest-numbered CPU that still holds no process, or returns -1. */
+    auto takeIdleCore = [&]() {
+        while (!idleCores.empty()) {
+            int c = idleCores.back();
+            idleCores.pop_back();
+            cores[c].listedIdle = false;
+            if (cores[c].load == 0) return c;
+        }
+        return -1;
+    };
+
+    auto decide = [&](int c) {
+        Core& core = cores[c];
+        core.decisionPending = false;
+        core.advance(currentTime);
+        statsTick();
+        int next = core.policy->schedule(core.running, currentTime, core.sliceExpired);
+        if (next != core.running || core.sliceExpired) {
+            bool switched = (next != core.running);
+            bool preempted = switched && core.running != NO_PROCESS;
+            if (preempted) {
+                preemptions++;
+                ProcessState& state = core.states[core.running];
+                if (state.startTime > currentTime) state.startTime = state.responseTime = -1; // Its switch never finished
+                if (trace) trace->record(TraceEventType::Preemption, currentTime, core.processes.ids[core.running], c, state.remainingBurstTime);
+            }
+            core.running = next;
+            if (next != NO_PROCESS) {
+                ProcessState& state = core.states[next];
+                core.dispatchId++;
+                int switchCost = 0;
+                if (switched) {
+                    contextSwitches++;
+                    switchCost = preempted ? options.contextSwitch.preemption : options.contextSwitch.voluntary;
+                }
+                core.switchUntil = currentTime + switchCost;
+                if (state.startTime == -1) {
+                    state.startTime = core.switchUntil;
+                    state.responseTime = state.startTime - core.processes.arrivalTimes[next];
+                }
+                int slice = core.policy->sliceLength(next);
+                if (trace && switched) {
+                    trace->record(TraceEventType::Dispatch, core.switchUntil, core.processes.ids[next], c, slice == SchedulingPolicy::UNBOUNDED_SLICE ? -1 : slice);
+                }
+                if (state.remainingBurstTime <= slice) {
+                    events.push(core.switchUntil + state.remainingBurstTime, EventType::Completion, core.dispatchId, c);
+                } else {
+                    events.push(core.switchUntil + slice, EventType::SliceEnd, core.dispatchId, c);
+                }
+            }
+        }
+        core.sliceExpired = false;
+
+        int timer = core.policy->nextTimerTime();
+        if (timer > currentTime && timer < core.pendingTimer) {
+            events.push(timer, EventType::Timer, 0, c);
+            core.pendingTimer = timer;
+        }
+        updateBacklog(c);
+        listIfIdle(c);
+    };
+
+    /** Lets every idle CPU take the next process of the CPU with the most ready processes, while there are any. */
+    auto balance = [&]() {
+        while (!backlog.empty()) {
+            int thiefIndex = takeIdleCore();
+            if (thiefIndex < 0) return;
+            int victimIndex = backlog.top();
+            Core& victim = cores[victimIndex];
+            Core& thief = cores[thiefIndex];
+
+            victim.advance(currentTime);
+            int from = victim.policy->steal();
+            if (from == NO_PROCESS) {
+                backlog.erase(victimIndex);
+                listIfIdle(thiefIndex);
+                continue;
+            }
+            int to = thief.allocate();
+            thief.processes.store(to, victim.processes, from);
+            thief.states[to] = victim.states[from];
+            thief.states[to].remainingBurstTime += config.migrationCost;
+            if (hasIo) {
+                if (thief.io.size() < thief.states.size()) thief.io.resize(thief.states.size());
+                thief.io[to] = victim.io[from];
+            }
+            victim.freeSlots.push_back(from);
+            victim.load--;
+            updateBacklog(victimIndex);
+
+            thief.load++;
+            if (trace) trace->record(TraceEventType::Migration, currentTime, thief.processes.ids[to], thiefIndex, victimIndex);
+            thief.policy->admit(to, currentTime);
+            migrations++;
+            decide(thiefIndex);
+        }
+    };
+
+    auto place = [&](size_t index) {
+        int c = takeIdleCore();
+        if (c < 0) {
+            c = nextCore;
+            nextCore = (nextCore + 1) % config.cores;
+        }
+        Core& core = cores[c];
+        touch(c);
+        int slot = core.allocate();
+        core.processes.store(slot, workload, index);
+        core.states[slot] = ProcessState(workload.burstTimes[index]);
+        if (hasIo) {
+            if (core.io.size() < core.states.size()) core.io.resize(core.states.size());
+            core.io[slot] = IoProgress(workload.burstSequence(index), workload.burstCount(index), workload.burstTimes[index]);
+        }
+        core.load++;
+        if (trace) trace->record(TraceEventType::Arrival, currentTime, workload.ids[index], c, c);
+        core.policy->admit(slot, currentTime);
+    };
+
+    auto wake = [&](const IoRequest& request) {
+        Core& core = cores[request.core];
+        touch(request.core);
+        core.states[request.slot].remainingBurstTime = core.io[request.slot].wake(currentTime);
+        core.load++;
+        if (trace) trace->record(TraceEventType::Wakeup, currentTime, core.processes.ids[request.slot], request.core, request.device);
+        core.policy->wake(request.slot, currentTime);
+    };
+
+    if (workload.size() > 0) {
+        events.push(std::max(workload.arrivalTimes[0], currentTime), EventType::Arrival);
+    }
+
+    while ((nextArrival < workload.size() || inFlight > 0) && !events.empty()) {
+        Event event = events.top();
+        events.pop();
+        eventCount++;
+        if (isStale(event)) continue;
+        currentTime = std::max(currentTime, event.time);
+
+        switch (event.type) {
+            case EventType::Arrival:
+                while (nextArrival < workload.size() && workload.arrivalTimes[nextArrival] <= currentTime) {
+                    arrived.push_back(nextArrival++);
+                    inFlight++;
+                }
+                if (nextArrival < workload.size()) {
+                    events.push(workload.arrivalTimes[nextArrival], EventType::Arrival);
+                }
+                break;
+            case EventType::Completion: {
+                Core& core = cores[event.core];
+                touch(event.core);
+                ProcessState& state = core.states[core.running];
+                state.remainingBurstTime = 0;
+                if (hasIo && core.io[core.running].blocksAfterBurst()) {
+                    int ioBurst = core.io[core.running].block(currentTime);
+                    if (trace) trace->record(TraceEventType::Block, currentTime, core.processes.ids[core.running], event.core, ioBurst);
+                    devices.submit(IoRequest{core.running, event.core, ioBurst, currentTime, -1}, events);
+                    core.load--;
+                    core.running = NO_PROCESS;
+                    listIfIdle(event.core);
+                    break;
+                }
+                state.completionTime = currentTime;
+                if (trace) trace->record(TraceEventType::Completion, currentTime, core.processes.ids[core.running], event.core, 0);
+                int service = hasIo ? core.io[core.running].totalService() : core.processes.burstTimes[core.running];
+                metrics.record(core.processes.arrivalTimes[core.running], service, state);
+                core.freeSlots.push_back(core.running);
+                core.load--;
+                core.running = NO_PROCESS;
+                inFlight--;
+                listIfIdle(event.core);
+                break;
+            }
+            case EventType::SliceEnd:
+                touch(event.core);
+                cores[event.core].sliceExpired = true;
+                break;
+            case EventType::Timer:
+                touch(event.core);
+                if (event.time == cores[event.core].pendingTimer) cores[event.core].pendingTimer = SchedulingPolicy::NO_TIMER;
+                break;
+            case EventType::IoComplete:
+                woken.push_back(devices.finish(event.core, currentTime, events));
+                break;
+        }
+
+        while (!events.empty() && isStale(events.top())) {
+            events.pop();
+            eventCount++;
+        }
+        if (!events.empty() && events.top().time == currentTime) continue;
+
+        for (size_t index : arrived) place(index);
+        arrived.clear();
+        for (const IoRequest& request : woken) wake(request);
+        woken.clear();
+        for (size_t i = 0; i < touched.size(); ++i) decide(touched[i]);
+        touched.clear();
+        balance();
+    }
+
+    long long totalBusy = 0;
+    long long maxBusy = 0;
+    long long totalSwitchTime = 0;
+    for (Core& core : cores) {
+        core.advance(currentTime);
+        totalBusy += core.busyTime;
+        totalSwitchTime += core.switchTime;
+        maxBusy = std::max(maxBusy, core.busyTime);
+        result.coreUtilization.push_back(currentTime > 0 ? static_cast<double>(core.busyTime) / currentTime * 100.0 : 0.0);
+    }
+
+    metrics.fill(result, currentTime, 0, totalSwitchTime);
+    devices.fill(result, currentTime);
+    result.cpuUtilization = (currentTime > 0) ? static_cast<double>(totalBusy) / (static_cast<double>(currentTime) * config.cores) * 100.0 : 0.0;
+    double meanBusy = static_cast<double>(totalBusy) / config.cores;
+    result.loadImbalance = (meanBusy > 0) ? (maxBusy / meanBusy - 1.0) * 100.0 : 0.0;
+    result.migrations = migrations;
+    result.contextSwitches = contextSwitches;
+    result.preemptions = preemptions;
+    result.eventCount = eventCount;
+    statsScope.finish(result);
+    return result;
+}
@@ -0,0 +1,142 @@
+#ifndef SIMULATION_ENGINE_H
+#define SIMULATION_ENGINE_H
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <memory>
+#include "Process.h"
+#include "Workload.h"
+#include "Scheduler.h"
+#include "TraceRecorder.h"
+#include "SchedulingPolicy.h"
+#include "EventLoop.h"
+
+class ProcessStream;
+
+/**
+ * Discrete-event simulation core shared by all scheduling algorithms.
+ * Instead of advancing one time unit per iteration, the engine jumps directly between events
+ * (arrivals, completions, slice ends and policy timers), so the cost of a run grows with the
+ * number of events rather than with the total simulated time. Metrics are accumulated as processes
+ * complete, so no copy of the finished processes is kept.
+ * Every dispatch of a different process first spends the configured context-switch cost, during which the CPU
+ * neither runs a process nor idles; the process's slice and completion are counted from the end of the switch.
+ * With a TraceRecorder, arrivals, dispatches, preemptions and completions (and policy events) are recorded into it;
+ * without one, the only cost is a null check at each of those points.
+ */
+class SimulationEngine {
+public:
+    /** Runs over a shared, already sorted workload; the workload (and options.trace, if set) must outlive the engine. */
+    explicit SimulationEngine(const Workload& workload, const SimulationOptions& options = SimulationOptions());
+
+    /**
+     * Runs the given policy over the workload with a fresh ProcessState arena and returns the aggregated metrics.
+     * The event loop is instantiated for Policy, so a final policy class is called without virtual dispatch in the
+     * hot loop; passing a SchedulingPolicy reference runs the same loop through the virtual interface.
+     */
+    template <typename Policy>
+    SimulationResult run(Policy& policy, const std::string& algorithmName) {
+        WorkloadArrivals arrivals(workload);
+        return runEventLoop(arrivals, policy, algorithmName, 0, nullptr, options);
+    }
+
+private:
+    const Workload& workload;
+    SimulationOptions options;
+};
+
+/**
+ * Runs a policy over a ProcessStream instead of an in-memory workload.
+ * Processes are read one arrival group ahead and live in a slot table only while in flight; completed slots are
+ * reused, so memory grows with the largest number of simultaneously active processes, not with the stream length.
+ * Processes arriving at the same time are admitted in ID order, so results match SimulationEngine on the same workload.
+ * With a positive snapshotInterval, onSnapshot receives interim metrics at every multiple of it in simulated time.
+ */
+class StreamingSimulationEngine {
+public:
+    StreamingSimulationEngine(ProcessStream& stream, int snapshotInterval = 0, SnapshotCallback onSnapshot = nullptr,
+                              const SimulationOptions& options = SimulationOptions());
+
+    /** Consumes the stream with the given policy; a stream can only be run once. */
+    SimulationResult run(SchedulingPolicy& policy, const std::string& algorithmName);
+
+    /** Largest number of processes that were in flight (admitted but not completed) at once. */
+    size_t peakInFlight() const { return peakSlots; }
+
+private:
+    ProcessStream& stream;
+    int snapshotInterval;
+    SnapshotCallback onSnapshot;
+    SimulationOptions options;
+    size_t peakSlots;
+};
+
+/**
+ * Single-CPU runs of one policy over a baseline workload and edited copies of it (what-if scenarios).
+ * The baseline run copies the complete engine state (event queue, running process and dispatch state, the policy's
+ * ready structure, process states, I/O devices and metric accumulators) at the first instant at or after every
+ * multiple of checkpointInterval. A rerun finds the earliest arrival time at which the edited workload differs from
+ * the baseline and resumes from the last checkpoint before it, so only the rest of the run is simulated again; the
+ * result equals a full run of the edited workload. Each checkpoint holds per-process state of the admitted processes
+ * and the policy, so memory grows with the number of processes times the number of checkpoints.
+ */
+class CheckpointedSimulation {
+public:
+    /** prototype must be freshly constructed; it is cloned for every run from time 0. Checkpointed runs cannot be traced. */
+    CheckpointedSimulation(const SchedulingPolicy& prototype, const std::string& algorithmName, int checkpointInterval,
+                           const SimulationOptions& options = SimulationOptions());
+    ~CheckpointedSimulation();
+
+    /** Runs the baseline from time 0, replacing any earlier checkpoints; workload must outlive every rerun. */
+    SimulationResult run(const Workload& workload);
+
+    /**
+     * Runs an edited copy of the baseline, resuming from the latest checkpoint that the edit does not affect.
+     * Reruns leave the checkpoints unchanged, so every scenario is compared with the same baseline and several
+     * reruns may run concurrently. Throws runtime error if the baseline has not been run.
+     */
+    WhatIfRun rerun(const Workload& edited) const;
+
+    size_t checkpointCount() const;
+
+private:
+    std::unique_ptr<SchedulingPolicy> prototype;
+    std::string algorithmName;
+    int checkpointInterval;
+    SimulationOptions options;
+    const Workload* baseline;
+    std::vector<SimulationCheckpoint> checkpoints;
+};
+
+/** Shape of a simulated multi-CPU machine. */
+struct MultiCoreConfig {
+    int cores = 1;
+    int migrationCost = 0; // Extra run time a process needs after being moved to another CPU (cache and TLB refill)
+
+    /** Throws runtime error unless cores >= 1 and migrationCost >= 0. */
+    void validate() const;
+};
+
+/**
+ * Runs a policy on several CPUs, each with its own clone of the policy as a private ready queue.
+ * An arriving process goes to a CPU with nothing to do if there is one and otherwise to the CPUs in turn.
+ * Whenever a CPU would idle it steals the process the most loaded CPU would run next, paying migrationCost.
+ * Each CPU keeps its own slot table of the processes it holds, so memory grows with the processes in flight, and
+ * per-event work is O(log cores); 256 CPUs cost little more than one. With one CPU the results equal SimulationEngine's.
+ */
+class MultiCoreSimulationEngine {
+public:
+    /** The workload (and options.trace, if set) must outlive the engine; traced events carry the CPU they happened on. */
+    MultiCoreSimulationEngine(const Workload& workload, const MultiCoreConfig& config, const SimulationOptions& options = SimulationOptions());
+
+    /** Clones prototype (which must be freshly constructed) onto every CPU and runs the workload. */
+    SimulationResult run(const SchedulingPolicy& prototype, const std::string& algorithmName);
+
+private:
+    const Workload& workload;
+    MultiCoreConfig config;
+    SimulationOptions options;
+};
+
+#endif
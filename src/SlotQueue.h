@@ -0,0 +1,68 @@
+#ifndef SLOT_QUEUE_H
+#define SLOT_QUEUE_H
+
+#include <array>
+#include <vector>
+#include <cstddef>
+
+/**
+ * A fixed number of FIFO queues of process slots, intrusively linked through one per-slot array.
+ * The link of a slot is its entry in that array, so a slot can sit in at most one of the queues at a time, which
+ * holds for a ready queue: the running process is not in it, and an MLFQ process is on a single level.
+ * Push and pop only rewrite links. Once reserve has covered every slot, no operation allocates, however often
+ * processes are requeued. Used as the FCFS, Round Robin and MLFQ ready queues.
+ */
+template <int Queues = 1>
+class SlotQueues {
+public:
+    static constexpr int NONE = -1;
+
+    SlotQueues() {
+        ends.fill(Ends{NONE, NONE});
+    }
+
+    /** Makes room for slots [0, count); it only grows, like the rest of a policy's per-slot state. */
+    void reserve(size_t count) {
+        if (next.size() < count) next.resize(count, NONE);
+    }
+
+    bool empty(int queue = 0) const { return ends[queue].head == NONE; }
+
+    /** Oldest slot of the queue, which must not be empty. */
+    int front(int queue = 0) const { return ends[queue].head; }
+
+    /** Appends slot, which must be reserved and in none of the queues. */
+    void push(int slot, int queue = 0) {
+        Ends& end = ends[queue];
+        next[slot] = NONE;
+        if (end.tail == NONE) {
+            end.head = slot;
+        } else {
+            next[end.tail] = slot;
+        }
+        end.tail = slot;
+    }
+
+    /** Removes and returns the oldest slot of the queue, which must not be empty. */
+    int pop(int queue = 0) {
+        Ends& end = ends[queue];
+        int slot = end.head;
+        end.head = next[slot];
+        if (end.head == NONE) end.tail = NONE;
+        return slot;
+    }
+
+private:
+    struct Ends {
+        int head;
+        int tail;
+    };
+
+    std::array<Ends, Queues> ends;
+    std::vector<int> next; // Slot queued behind each slot, NONE at a tail
+};
+
+/** A single slot FIFO. */
+typedef SlotQueues<1> SlotQueue;
+
+#endif
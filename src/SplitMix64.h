@@ -0,0 +1,45 @@
+#ifndef SPLITMIX64_H
+#define SPLITMIX64_H
+
+#include <cstdint>
+
+/** SplitMix64: small, fast and fully specified, so a seed gives the same sequence on every platform. */
+class SplitMix64 {
+public:
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /** Uniform double in (0, 1], safe to pass to log. */
+    double uniform() {
+        return static_cast<double>((next() >> 11) + 1) * (1.0 / 9007199254740992.0);
+    }
+
+    /** Integer in [0, bound) for bound > 0, by multiply-shift (bias below bound / 2^64). */
+    uint64_t below(uint64_t bound) {
+        return multiplyHigh(next(), bound);
+    }
+
+private:
+    uint64_t state;
+
+    /** High 64 bits of the 128-bit product a * b, from four 32-bit partial products (no compiler extensions). */
+    static uint64_t multiplyHigh(uint64_t a, uint64_t b) {
+        uint64_t aLow = a & 0xFFFFFFFFULL, aHigh = a >> 32;
+        uint64_t bLow = b & 0xFFFFFFFFULL, bHigh = b >> 32;
+        uint64_t lowLow = aLow * bLow;
+        uint64_t highLow = aHigh * bLow;
+        uint64_t lowHigh = aLow * bHigh;
+        uint64_t highHigh = aHigh * bHigh;
+        // Middle column: neither sum can overflow, as each partial product is at most (2^32 - 1)^2
+        uint64_t middle = (lowLow >> 32) + (highLow & 0xFFFFFFFFULL) + lowHigh;
+        return highHigh + (highLow >> 32) + (middle >> 32);
+    }
+};
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <atomic>
+
+/**
+ * Fixed-size work-stealing pool of worker threads.
+ * Submitted tasks are spread round-robin over per-worker deques. A worker takes from the back of its own
+ * deque and, when that is empty, steals from the front of the others, so a few long tasks (e.g. a tiny RR
+ * quantum in a sweep) do not leave the remaining workers idle behind them.
+ * submit() returns a std::future for the task's result, so callers can collect results in submission order
+ * regardless of which worker finishes first. The destructor drains all tasks and joins the workers.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threadCount) : nextQueue(0), pendingTasks(0), stopping(false) {
+        if (threadCount == 0) threadCount = 1;
+        for (size_t i = 0; i < threadCount; ++i) {
+            queues.emplace_back(new WorkerQueue());
+        }
+        for (size_t i = 0; i < threadCount; ++i) {
+            workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    /** Queues a callable for execution and returns a future for its result. */
+    template <typename F>
+    auto submit(F task) -> std::future<decltype(task())> {
+        typedef decltype(task()) R;
+        auto packaged = std::make_shared<std::packaged_task<R()>>(std::move(task));
+        std::future<R> result = packaged->get_future();
+
+        WorkerQueue& queue = *queues[nextQueue++ % queues.size()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back([packaged] { (*packaged)(); });
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            pendingTasks++;
+        }
+        wakeup.notify_one();
+        return result;
+    }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    /**
+     * Each worker first claims one pending task under the sleep lock, then searches the deques for it.
+     * A task is always pushed before it is counted, so a claimed task is guaranteed to be found.
+     */
+    void workerLoop(size_t index) {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                wakeup.wait(lock, [this] { return stopping || pendingTasks > 0; });
+                if (pendingTasks == 0) return; // Stopping and fully drained
+                pendingTasks--;
+            }
+
+            std::function<void()> task;
+            while (!task) {
+                if (!takeOwn(index, task)) steal(index, task);
+            }
+            task();
+        }
+    }
+
+    bool takeOwn(size_t index, std::function<void()>& task) {
+        WorkerQueue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_t index, std::function<void()>& task) {
+        for (size_t offset = 1; offset < queues.size(); ++offset) {
+            WorkerQueue& victim = *queues[(index + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> nextQueue;
+    std::mutex sleepMutex;
+    std::condition_variable wakeup;
+    size_t pendingTasks;
+    bool stopping;
+};
+
+#endif
@@ -0,0 +1,130 @@
+#include "TraceRecorder.h"
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
+
+/** Bytes of formatted JSON collected before each write. */
+static const size_t TRACE_BUFFER_SIZE = 1 << 20;
+
+/** Collects formatted JSON records in a large buffer and writes it out when full, separating records with commas. */
+class TraceWriter {
+public:
+    explicit TraceWriter(std::ofstream& out) : out(out), first(true) {
+        buffer.reserve(TRACE_BUFFER_SIZE + 512);
+    }
+
+    /** Appends one record (a complete JSON object) to the traceEvents array. */
+    void add(const char* record, int length) {
+        if (!first) buffer += ",\n";
+        first = false;
+        buffer.append(record, length);
+        if (buffer.size() >= TRACE_BUFFER_SIZE) flush();
+    }
+
+    void add(const std::string& record) { add(record.data(), static_cast<int>(record.size())); }
+
+    void flush() {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+
+private:
+    std::ofstream& out;
+    std::string buffer;
+    bool first;
+};
+
+/** Escapes text for a JSON string literal (control characters become spaces). */
+static std::string jsonString(const std::string& text) {
+    std::string escaped = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += (static_cast<unsigned char>(c) < 0x20) ? ' ' : c;
+    }
+    return escaped + "\"";
+}
+
+/** Writes the metadata and events of one run as trace process pid. */
+static void writeRun(TraceWriter& writer, const NamedTrace& run, int pid) {
+    char record[512];
+    const TraceRecorder& trace = *run.trace;
+
+    int maxCore = 0;
+    for (size_t i = 0; i < trace.size(); ++i) maxCore = std::max(maxCore, trace[i].core);
+    int arrivalsTrack = maxCore + 1;
+
+    std::string name = run.name;
+    if (trace.dropped() > 0) name += " (oldest " + std::to_string(trace.dropped()) + " events dropped)";
+    writer.add("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" + std::to_string(pid) + ",\"args\":{\"name\":" + jsonString(name) + "}}");
+    for (int core = 0; core <= maxCore; ++core) {
+        writer.add(record, std::snprintf(record, sizeof(record), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"CPU %d\"}}",
+                                         pid, core, core));
+    }
+    writer.add(record, std::snprintf(record, sizeof(record), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"Arrivals\"}}",
+                                     pid, arrivalsTrack));
+
+    // Dispatch (stamped with the end of its context switch) opens a slice on its CPU; the next Preemption, Block or
+    // Completion of the same process closes it. A slice whose Dispatch was overwritten in the ring buffer, or that was preempted
+    // before its switch finished, is left out.
+    std::vector<int> openProcess(maxCore + 1, -1);
+    std::vector<int> openSince(maxCore + 1, 0);
+    for (size_t i = 0; i < trace.size(); ++i) {
+        const TraceEvent& e = trace[i];
+        int length = 0;
+        switch (e.type) {
+            case TraceEventType::Arrival:
+                length = std::snprintf(record, sizeof(record),
+                                       "{\"name\":\"P%d arrives\",\"cat\":\"arrival\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%d,\"pid\":%d,\"tid\":%d,\"args\":{\"cpu\":%d}}",
+                                       e.processId, e.time, pid, arrivalsTrack, e.detail);
+                break;
+            case TraceEventType::Dispatch:
+                openProcess[e.core] = e.processId;
+                openSince[e.core] = e.time;
+                break;
+            case TraceEventType::Preemption:
+            case TraceEventType::Completion:
+            case TraceEventType::Block:
+                if (openProcess[e.core] == e.processId && (e.type != TraceEventType::Preemption || e.time > openSince[e.core])) {
+                    bool preempted = (e.type == TraceEventType::Preemption);
+                    const char* end = preempted ? "preempted" : (e.type == TraceEventType::Block ? "blocked on I/O" : "completed");
+                    length = std::snprintf(record, sizeof(record),
+                                           "{\"name\":\"P%d\",\"cat\":\"run\",\"ph\":\"X\",\"ts\":%d,\"dur\":%d,\"pid\":%d,\"tid\":%d,\"args\":{\"end\":\"%s\",\"remaining\":%d}}",
+                                           e.processId, openSince[e.core], e.time - openSince[e.core], pid, e.core,
+                                           end, preempted ? e.detail : 0);
+                }
+                openProcess[e.core] = -1;
+                break;
+            case TraceEventType::Demotion:
+            case TraceEventType::Boost:
+                length = std::snprintf(record, sizeof(record),
+                                       "{\"name\":\"P%d %s to Q%d\",\"cat\":\"mlfq\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%d,\"pid\":%d,\"tid\":%d}",
+                                       e.processId, e.type == TraceEventType::Demotion ? "demoted" : "boosted", e.detail, e.time, pid, e.core);
+                break;
+            case TraceEventType::Migration:
+                length = std::snprintf(record, sizeof(record),
+                                       "{\"name\":\"P%d migrated from CPU %d\",\"cat\":\"migration\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%d,\"pid\":%d,\"tid\":%d}",
+                                       e.processId, e.detail, e.time, pid, e.core);
+                break;
+            case TraceEventType::Wakeup:
+                length = std::snprintf(record, sizeof(record),
+                                       "{\"name\":\"P%d wakes (I/O %d done)\",\"cat\":\"io\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%d,\"pid\":%d,\"tid\":%d}",
+                                       e.processId, e.detail, e.time, pid, e.core);
+                break;
+        }
+        if (length > 0) writer.add(record, length);
+    }
+}
+
+void writeChromeTrace(const std::string& filename, const std::vector<NamedTrace>& runs) {
+    std::ofstream out(filename, std::ios::trunc | std::ios::binary);
+    if (!out) throw std::runtime_error("Error opening file for writing: " + filename);
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    TraceWriter writer(out);
+    for (size_t i = 0; i < runs.size(); ++i) {
+        if (runs[i].trace != nullptr) writeRun(writer, runs[i], static_cast<int>(i) + 1);
+    }
+    writer.flush();
+    out << "\n]}\n";
+    if (!out) throw std::runtime_error("Error writing file: " + filename);
+}
@@ -0,0 +1,97 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+/** Kinds of scheduling events a trace records. */
+enum class TraceEventType : uint8_t {
+    Arrival,    // A process entered the system (detail: CPU it was placed on)
+    Dispatch,   // A process starts running, after any context switch (detail: granted slice, or -1 if unbounded)
+    Preemption, // The running process lost the CPU before finishing (detail: remaining burst)
+    Completion, // The running process finished its burst
+    Demotion,   // MLFQ moved a process down after its quantum expired (detail: new level)
+    Boost,      // MLFQ aging moved a waiting process up (detail: new level)
+    Migration,  // Work stealing moved a ready process to this CPU (detail: CPU it came from)
+    Block,      // The running process finished a CPU burst and waits for I/O (detail: I/O burst length)
+    Wakeup      // A blocked process's I/O finished and it is ready on this CPU again (detail: I/O device)
+};
+
+/** One recorded event; processId is the workload's process ID, not the engine's slot. */
+struct TraceEvent {
+    int time;
+    int processId;
+    int core;
+    int detail;
+    TraceEventType type;
+};
+
+/**
+ * Fixed-capacity ring buffer of scheduling events.
+ * The whole buffer is allocated up front, so recording is a store and an index increment and never allocates.
+ * Once full, each new event overwrites the oldest one, so a long run keeps its most recent capacity events.
+ * The engines take a TraceRecorder pointer and only record when it is non-null, which keeps untraced runs unaffected.
+ */
+class TraceRecorder {
+public:
+    static const size_t DEFAULT_CAPACITY = size_t(1) << 20;
+
+    explicit TraceRecorder(size_t capacity = DEFAULT_CAPACITY) : events(capacity), head(0), recorded(0) {
+        if (capacity == 0) throw std::runtime_error("The trace capacity must be at least 1");
+    }
+
+    void record(TraceEventType type, int time, int processId, int core, int detail) {
+        TraceEvent& event = events[head];
+        event.time = time;
+        event.processId = processId;
+        event.core = core;
+        event.detail = detail;
+        event.type = type;
+        if (++head == events.size()) head = 0;
+        recorded++;
+    }
+
+    size_t capacity() const { return events.size(); }
+
+    /** Number of events currently held (at most capacity). */
+    size_t size() const { return recorded < events.size() ? static_cast<size_t>(recorded) : events.size(); }
+
+    /** Events overwritten because the buffer was full. */
+    uint64_t dropped() const { return recorded - size(); }
+
+    /** The i-th held event, oldest first. */
+    const TraceEvent& operator[](size_t i) const {
+        size_t start = recorded < events.size() ? 0 : head;
+        size_t index = start + i;
+        return events[index < events.size() ? index : index - events.size()];
+    }
+
+    void clear() {
+        head = 0;
+        recorded = 0;
+    }
+
+private:
+    std::vector<TraceEvent> events;
+    size_t head;        // Where the next event is written
+    uint64_t recorded;  // Events recorded since the last clear, including overwritten ones
+};
+
+/** A recorded run and the name its timeline is shown under. */
+struct NamedTrace {
+    std::string name;
+    const TraceRecorder* trace;
+};
+
+/**
+ * Writes the runs as one Chrome trace-event JSON file, which chrome://tracing and Perfetto (ui.perfetto.dev) open.
+ * Each run becomes a trace process with one track per CPU showing which process ran when, plus an Arrivals track.
+ * Demotions, boosts, migrations and I/O wakeups are instant events on the CPU track. One simulation time unit is shown as 1 us.
+ * Throws runtime error if the file cannot be written.
+ */
+void writeChromeTrace(const std::string& filename, const std::vector<NamedTrace>& runs);
+
+#endif
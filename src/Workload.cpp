@@ -0,0 +1,64 @@
+#include "Workload.h"
+#include <algorithm>
+
+Workload::Workload(std::vector<Process> processes) {
+    std::sort(processes.begin(), processes.end(), [](const Process& a, const Process& b) {
+        if (a.arrivalTime != b.arrivalTime) return a.arrivalTime < b.arrivalTime;
+        return a.id < b.id;
+    });
+
+    ids.reserve(processes.size());
+    arrivalTimes.reserve(processes.size());
+    burstTimes.reserve(processes.size());
+    priorities.reserve(processes.size());
+    for (const Process& p : processes) {
+        ids.push_back(p.id);
+        arrivalTimes.push_back(p.arrivalTime);
+        burstTimes.push_back(p.burstTime);
+        priorities.push_back(p.priority);
+    }
+
+    bool anyIo = std::any_of(processes.begin(), processes.end(), [](const Process& p) { return !p.ioCpuBursts.empty(); });
+    if (!anyIo) return;
+    burstOffsets.reserve(processes.size() + 1);
+    burstOffsets.push_back(0);
+    for (const Process& p : processes) {
+        bursts.insert(bursts.end(), p.ioCpuBursts.begin(), p.ioCpuBursts.end());
+        burstOffsets.push_back(bursts.size());
+    }
+}
+
+Process Workload::process(size_t slot) const {
+    Process p(ids[slot], arrivalTimes[slot], burstTimes[slot], priorities[slot]);
+    int count = burstCount(slot);
+    if (count > 0) p.ioCpuBursts.assign(burstSequence(slot), burstSequence(slot) + count);
+    return p;
+}
+
+void Workload::store(size_t slot, const Process& p) {
+    store(slot, p.id, p.arrivalTime, p.burstTime, p.priority);
+}
+
+void Workload::store(size_t slot, const Workload& source, size_t sourceSlot) {
+    store(slot, source.ids[sourceSlot], source.arrivalTimes[sourceSlot], source.burstTimes[sourceSlot], source.priorities[sourceSlot]);
+}
+
+void Workload::store(size_t slot, int id, int arrivalTime, int burstTime, int priority) {
+    if (slot == ids.size()) {
+        ids.push_back(id);
+        arrivalTimes.push_back(arrivalTime);
+        burstTimes.push_back(burstTime);
+        priorities.push_back(priority);
+        return;
+    }
+    if (slot > ids.size()) {
+        ids.resize(slot + 1);
+        arrivalTimes.resize(slot + 1);
+        burstTimes.resize(slot + 1);
+        priorities.resize(slot + 1);
+    }
+    ids[slot] = id;
+    arrivalTimes[slot] = arrivalTime;
+    burstTimes[slot] = burstTime;
+    priorities[slot] = priority;
+}
@@ -0,0 +1,68 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <vector>
+#include <cstddef>
+#include "Process.h"
+
+/**
+ * Read-only workload shared by every simulation run, stored as columns (structure of arrays).
+ * Processes are sorted once by arrival time (ties by ID); slot i refers to the i-th process in that order
+ * in every column and in a run's ProcessState arena. Runs never modify it, so any number of them, on any
+ * number of threads, can share one instance.
+ * The I/O and later CPU bursts of processes that do I/O are kept in one flat array indexed by burstOffsets; both stay
+ * empty when no process does I/O, so CPU-only workloads pay nothing for them.
+ */
+struct Workload {
+    std::vector<int> ids;
+    std::vector<int> arrivalTimes;
+    std::vector<int> burstTimes;
+    std::vector<int> priorities;
+    std::vector<size_t> burstOffsets; // Slot i's sequence is bursts[burstOffsets[i], burstOffsets[i + 1])
+    std::vector<int> bursts;          // Process::ioCpuBursts of every process, in slot order
+
+    Workload() {}
+
+    /** Sorts the processes by arrival time (ties by ID) and splits them into columns. */
+    explicit Workload(std::vector<Process> processes);
+
+    size_t size() const { return ids.size(); }
+
+    /** True if any process has bursts after its first CPU burst. */
+    bool hasIo() const { return !burstOffsets.empty(); }
+
+    /** Number of entries in slot's I/O, CPU, ... sequence (0 for a CPU-only process) and a pointer to them. */
+    int burstCount(size_t slot) const { return hasIo() ? static_cast<int>(burstOffsets[slot + 1] - burstOffsets[slot]) : 0; }
+    const int* burstSequence(size_t slot) const { return bursts.data() + burstOffsets[slot]; }
+
+    /** The process in slot as a Process record, bursts included (e.g. to build an edited copy of the workload). */
+    Process process(size_t slot) const;
+
+    /**
+     * Writes a process into slot, growing the columns if needed; used by the streaming engine, which reuses slots.
+     * Only the four scalar columns are written: engines that reuse slots track burst sequences themselves.
+     */
+    void store(size_t slot, const Process& p);
+
+    /** Copies slot sourceSlot of source into slot, growing the columns if needed (e.g. to move a process between CPUs). */
+    void store(size_t slot, const Workload& source, size_t sourceSlot);
+
+private:
+    void store(size_t slot, int id, int arrivalTime, int burstTime, int priority);
+};
+
+/**
+ * Mutable state of one process during one run, 16 bytes per process.
+ * A run allocates one arena of these indexed by slot instead of copying the whole Process records.
+ */
+struct ProcessState {
+    int remainingBurstTime;
+    int startTime;
+    int completionTime;
+    int responseTime;
+
+    ProcessState() : remainingBurstTime(0), startTime(-1), completionTime(-1), responseTime(-1) {}
+    explicit ProcessState(int burst) : remainingBurstTime(burst), startTime(-1), completionTime(-1), responseTime(-1) {}
+};
+
+#endif
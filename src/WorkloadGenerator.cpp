@@ -0,0 +1,303 @@
+#include "WorkloadGenerator.h"
+#include "SplitMix64.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <algorithm>
+
+/**
+ * Processes are generated in fixed-size blocks, each with its own random streams derived from the seed and
+ * the block index, so the output does not depend on how blocks are assigned to threads.
+ */
+static const uint64_t BLOCK_SIZE = 1 << 16;
+
+/** Independent stream for one block: stream 0 draws arrival gaps, stream 1 draws bursts and priorities. */
+static SplitMix64 blockStream(uint64_t seed, uint64_t block, uint64_t stream) {
+    SplitMix64 mixer(seed);
+    uint64_t base = mixer.next();
+    return SplitMix64(SplitMix64(base ^ (block * 2 + stream)).next());
+}
+
+/** Draws the gaps of one block; the bursty state starts from a fair coin and flips after each run. */
+class GapSampler {
+public:
+    GapSampler(const GeneratorConfig& config, uint64_t block) : config(config), rng(blockStream(config.seed, block, 0)) {
+        inBurst = config.arrivals == ArrivalPattern::Bursty && rng.uniform() <= 0.5;
+    }
+
+    double next() {
+        double rate = config.arrivalRate;
+        if (config.arrivals == ArrivalPattern::Bursty) {
+            if (rng.uniform() <= 1.0 / config.meanRunLength) inBurst = !inBurst;
+            if (inBurst) rate *= config.burstFactor;
+        }
+        return -std::log(rng.uniform()) / rate;
+    }
+
+private:
+    const GeneratorConfig& config;
+    SplitMix64 rng;
+    bool inBurst;
+};
+
+static int drawBurst(const GeneratorConfig& config, SplitMix64& rng) {
+    double burst;
+    switch (config.bursts) {
+        case BurstDistribution::Pareto: {
+            double scale = config.meanBurst * (config.paretoShape - 1.0) / config.paretoShape;
+            burst = scale / std::pow(rng.uniform(), 1.0 / config.paretoShape);
+            break;
+        }
+        case BurstDistribution::Bimodal: {
+            double mean = (rng.uniform() <= config.bimodalLongFraction) ? config.bimodalLongMean : config.bimodalShortMean;
+            burst = -mean * std::log(rng.uniform());
+            break;
+        }
+        default:
+            burst = -config.meanBurst * std::log(rng.uniform());
+            break;
+    }
+    burst = std::ceil(burst);
+    if (!(burst < config.maxBurst)) return config.maxBurst;
+    return std::max(1, static_cast<int>(burst));
+}
+
+/** Fills the I/O, CPU, ... bursts of a process that does I/O (exponential I/O lengths, CPU bursts as for the first one). */
+static void drawIoBursts(const GeneratorConfig& config, SplitMix64& rng, std::vector<int>& bursts) {
+    bursts.resize(2 * config.ioBurstCount);
+    for (int i = 0; i < config.ioBurstCount; ++i) {
+        double io = std::ceil(-config.meanIo * std::log(rng.uniform()));
+        bursts[2 * i] = (io < config.maxBurst) ? std::max(1, static_cast<int>(io)) : config.maxBurst;
+        bursts[2 * i + 1] = drawBurst(config, rng);
+    }
+}
+
+static int drawPriority(const GeneratorConfig& config, const std::vector<double>& cumulative, SplitMix64& rng) {
+    double target = rng.uniform() * cumulative.back();
+    size_t index = std::lower_bound(cumulative.begin(), cumulative.end(), target) - cumulative.begin();
+    return config.priorityMix[std::min(index, cumulative.size() - 1)].priority;
+}
+
+static uint64_t blockLength(const GeneratorConfig& config, uint64_t block) {
+    return std::min(BLOCK_SIZE, config.processCount - block * BLOCK_SIZE);
+}
+
+/** Runs body(block) for every block in [first, first + count), spreading the blocks over threadCount threads. */
+template <typename Body>
+static void forEachBlock(uint64_t first, uint64_t count, unsigned threadCount, Body body) {
+    unsigned workers = static_cast<unsigned>(std::min<uint64_t>(threadCount, count));
+    if (workers <= 1) {
+        for (uint64_t block = first; block < first + count; ++block) body(block);
+        return;
+    }
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < workers; ++t) {
+        threads.emplace_back([=] {
+            for (uint64_t block = first + t; block < first + count; block += workers) body(block);
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+}
+
+/**
+ * Generates blocks [first, first + count) into out, with the first block starting at arrival time offset.
+ * A first parallel pass only sums each block's gaps so the block start times can be computed in order; the
+ * second pass replays the same gaps from those start times and draws the bursts and priorities.
+ * Returns the start time of the block after the last one.
+ */
+static double generateBlocks(const GeneratorConfig& config, uint64_t first, uint64_t count, double offset,
+                             unsigned threadCount, std::vector<Process>& out) {
+    std::vector<double> durations(count);
+    forEachBlock(first, count, threadCount, [&](uint64_t block) {
+        GapSampler gaps(config, block);
+        double total = 0;
+        for (uint64_t i = 0, n = blockLength(config, block); i < n; ++i) total += gaps.next();
+        durations[block - first] = total;
+    });
+
+    std::vector<double> starts(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        starts[i] = offset;
+        offset += durations[i];
+    }
+    if (!(offset <= std::numeric_limits<int>::max())) {
+        throw std::runtime_error("Generated arrival times exceed the supported range; raise the arrival rate or lower the process count");
+    }
+
+    std::vector<double> cumulative;
+    double totalWeight = 0;
+    for (const PriorityWeight& entry : config.priorityMix) cumulative.push_back(totalWeight += entry.weight);
+
+    out.assign(std::min(count * BLOCK_SIZE, config.processCount - first * BLOCK_SIZE), Process(0, 0, 0, 0));
+    forEachBlock(first, count, threadCount, [&](uint64_t block) {
+        GapSampler gaps(config, block);
+        SplitMix64 attributes = blockStream(config.seed, block, 1);
+        Process* target = &out[(block - first) * BLOCK_SIZE];
+        double local = 0;
+        for (uint64_t i = 0, n = blockLength(config, block); i < n; ++i) {
+            local += gaps.next();
+            int arrival = static_cast<int>(starts[block - first] + local);
+            int burst = drawBurst(config, attributes);
+            target[i] = Process(static_cast<int>(block * BLOCK_SIZE + i + 1), arrival, burst, drawPriority(config, cumulative, attributes));
+            // Drawn only when enabled, so workloads without I/O keep the exact sequence of earlier versions
+            if (config.ioFraction > 0 && attributes.uniform() <= config.ioFraction) drawIoBursts(config, attributes, target[i].ioCpuBursts);
+        }
+    });
+    return offset;
+}
+
+void GeneratorConfig::validate() const {
+    if (processCount == 0 || processCount > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+        throw std::runtime_error("Process count must be between 1 and " + std::to_string(std::numeric_limits<int>::max()));
+    }
+    if (!(arrivalRate > 0)) throw std::runtime_error("Arrival rate must be positive");
+    if (!(burstFactor > 0)) throw std::runtime_error("Burst factor must be positive");
+    if (!(meanRunLength >= 1)) throw std::runtime_error("Mean burst run length must be at least 1");
+    if (!(meanBurst > 0)) throw std::runtime_error("Mean burst must be positive");
+    if (!(paretoShape > 1)) throw std::runtime_error("Pareto shape must be greater than 1");
+    if (!(bimodalShortMean > 0 && bimodalLongMean > 0)) throw std::runtime_error("Bimodal means must be positive");
+    if (!(bimodalLongFraction >= 0 && bimodalLongFraction <= 1)) throw std::runtime_error("Bimodal long fraction must be between 0 and 1");
+    if (maxBurst < 1) throw std::runtime_error("Maximum burst must be positive");
+    if (!(ioFraction >= 0 && ioFraction <= 1)) throw std::runtime_error("I/O fraction must be between 0 and 1");
+    if (ioBurstCount < 1 || ioBurstCount > 1000000) throw std::runtime_error("I/O bursts per process must be between 1 and 1000000");
+    if (!(meanIo > 0)) throw std::runtime_error("Mean I/O burst must be positive");
+    if (priorityMix.empty()) throw std::runtime_error("Priority mix is empty");
+    double totalWeight = 0;
+    for (const PriorityWeight& entry : priorityMix) {
+        if (!(entry.weight >= 0)) throw std::runtime_error("Priority weights must not be negative");
+        totalWeight += entry.weight;
+    }
+    if (!(totalWeight > 0)) throw std::runtime_error("Priority weights must not all be zero");
+}
+
+static double parseNumber(const std::string& name, const std::string& value) {
+    size_t used = 0;
+    double number = 0;
+    try {
+        number = std::stod(value, &used);
+    } catch (const std::exception& e) {
+        used = 0;
+    }
+    if (used == 0 || used != value.size()) throw std::runtime_error("Invalid value for --" + name + ": " + value);
+    return number;
+}
+
+static uint64_t parseUnsigned(const std::string& name, const std::string& value) {
+    size_t used = 0;
+    uint64_t number = 0;
+    try {
+        if (!value.empty() && value[0] != '-') number = std::stoull(value, &used);
+    } catch (const std::exception& e) {
+        used = 0;
+    }
+    if (used == 0 || used != value.size()) throw std::runtime_error("Invalid value for --" + name + ": " + value);
+    return number;
+}
+
+/** Splits on sep, keeping empty fields so that malformed lists are rejected. */
+static std::vector<std::string> split(const std::string& text, char sep) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t pos = text.find(sep, start);
+        fields.push_back(text.substr(start, pos - start));
+        if (pos == std::string::npos) return fields;
+        start = pos + 1;
+    }
+}
+
+bool applyGeneratorOption(GeneratorConfig& config, const std::string& name, const std::string& value) {
+    if (name == "count") {
+        config.processCount = parseUnsigned(name, value);
+    } else if (name == "seed") {
+        config.seed = parseUnsigned(name, value);
+    } else if (name == "arrivals") {
+        if (value == "poisson") config.arrivals = ArrivalPattern::Poisson;
+        else if (value == "bursty") config.arrivals = ArrivalPattern::Bursty;
+        else throw std::runtime_error("Unknown arrival pattern: " + value);
+    } else if (name == "rate") {
+        config.arrivalRate = parseNumber(name, value);
+    } else if (name == "burst-factor") {
+        config.burstFactor = parseNumber(name, value);
+    } else if (name == "burst-run") {
+        config.meanRunLength = parseNumber(name, value);
+    } else if (name == "bursts") {
+        if (value == "exponential") config.bursts = BurstDistribution::Exponential;
+        else if (value == "pareto") config.bursts = BurstDistribution::Pareto;
+        else if (value == "bimodal") config.bursts = BurstDistribution::Bimodal;
+        else throw std::runtime_error("Unknown burst distribution: " + value);
+    } else if (name == "mean-burst") {
+        config.meanBurst = parseNumber(name, value);
+    } else if (name == "pareto-shape") {
+        config.paretoShape = parseNumber(name, value);
+    } else if (name == "bimodal") {
+        std::vector<std::string> fields = split(value, ':');
+        if (fields.size() != 3) throw std::runtime_error("Expected SHORT:LONG:FRACTION for --bimodal: " + value);
+        config.bursts = BurstDistribution::Bimodal;
+        config.bimodalShortMean = parseNumber(name, fields[0]);
+        config.bimodalLongMean = parseNumber(name, fields[1]);
+        config.bimodalLongFraction = parseNumber(name, fields[2]);
+    } else if (name == "max-burst") {
+        uint64_t maxBurst = parseUnsigned(name, value);
+        if (maxBurst > static_cast<uint64_t>(std::numeric_limits<int>::max())) throw std::runtime_error("Invalid value for --" + name + ": " + value);
+        config.maxBurst = static_cast<int>(maxBurst);
+    } else if (name == "io-fraction") {
+        config.ioFraction = parseNumber(name, value);
+    } else if (name == "io-bursts") {
+        uint64_t count = parseUnsigned(name, value);
+        if (count > static_cast<uint64_t>(std::numeric_limits<int>::max())) throw std::runtime_error("Invalid value for --" + name + ": " + value);
+        config.ioBurstCount = static_cast<int>(count);
+    } else if (name == "mean-io") {
+        config.meanIo = parseNumber(name, value);
+    } else if (name == "priorities") {
+        std::vector<PriorityWeight> mix;
+        for (const std::string& item : split(value, ',')) {
+            std::vector<std::string> fields = split(item, ':');
+            if (fields.size() != 2) throw std::runtime_error("Expected PRIORITY:WEIGHT items for --priorities: " + value);
+            double priority = parseNumber(name, fields[0]);
+            if (priority != std::floor(priority) || std::fabs(priority) > std::numeric_limits<int>::max()) {
+                throw std::runtime_error("Invalid value for --" + name + ": " + value);
+            }
+            mix.push_back(PriorityWeight{static_cast<int>(priority), parseNumber(name, fields[1])});
+        }
+        config.priorityMix = mix;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::vector<Process> generateWorkload(const GeneratorConfig& config, unsigned threadCount) {
+    config.validate();
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<Process> processes;
+    uint64_t blocks = (config.processCount + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    generateBlocks(config, 0, blocks, 0.0, threadCount, processes);
+    return processes;
+}
+
+GeneratedProcessStream::GeneratedProcessStream(const GeneratorConfig& config, unsigned threadCount)
+    : config(config), threadCount(threadCount), nextBlock(0), blockOffset(0.0), batchIdx(0), produced(0) {
+    config.validate();
+    if (this->threadCount == 0) this->threadCount = std::max(1u, std::thread::hardware_concurrency());
+}
+
+/** Generates the next threadCount blocks, one per thread. */
+void GeneratedProcessStream::generateBatch() {
+    uint64_t blocks = (config.processCount + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    uint64_t count = std::min<uint64_t>(threadCount, blocks - nextBlock);
+    blockOffset = generateBlocks(config, nextBlock, count, blockOffset, threadCount, batch);
+    nextBlock += count;
+    batchIdx = 0;
+}
+
+bool GeneratedProcessStream::next(Process& process) {
+    if (batchIdx == batch.size()) {
+        if (produced == config.processCount) return false;
+        generateBatch();
+    }
+    process = batch[batchIdx++];
+    produced++;
+    return true;
+}
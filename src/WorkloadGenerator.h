@@ -0,0 +1,97 @@
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "Process.h"
+#include "WorkloadLoader.h"
+
+/** How inter-arrival gaps are drawn. */
+enum class ArrivalPattern {
+    Poisson, // Exponential gaps at arrivalRate
+    Bursty   // Alternates between runs at arrivalRate and runs at arrivalRate * burstFactor
+};
+
+/** Distribution of CPU burst lengths. */
+enum class BurstDistribution {
+    Exponential, // Mean meanBurst
+    Pareto,      // Shape paretoShape, scaled so the uncapped mean is meanBurst
+    Bimodal      // Exponential around bimodalShortMean, or around bimodalLongMean with probability bimodalLongFraction
+};
+
+/** A priority value and its relative weight in the generated mix. */
+struct PriorityWeight {
+    int priority;
+    double weight;
+};
+
+/**
+ * Parameters of a synthetic workload. Generation is deterministic for a given configuration: the same seed
+ * produces the same processes regardless of the thread count or of whether the workload is built in memory
+ * or streamed.
+ */
+struct GeneratorConfig {
+    uint64_t processCount = 1000;
+    uint64_t seed = 1;
+
+    ArrivalPattern arrivals = ArrivalPattern::Poisson;
+    double arrivalRate = 0.08;         // Arrivals per time unit (outside bursts for Bursty)
+    double burstFactor = 20.0;         // Bursty: rate multiplier inside a burst
+    double meanRunLength = 100.0;      // Bursty: mean number of arrivals before switching between calm and burst
+
+    BurstDistribution bursts = BurstDistribution::Exponential;
+    double meanBurst = 10.0;
+    double paretoShape = 1.5;
+    double bimodalShortMean = 4.0;
+    double bimodalLongMean = 100.0;
+    double bimodalLongFraction = 0.1;
+    int maxBurst = 1000000;            // Caps heavy-tailed draws
+
+    double ioFraction = 0.0;           // Share of processes that alternate CPU and I/O bursts
+    int ioBurstCount = 3;              // I/O bursts per such process, each followed by another CPU burst
+    double meanIo = 20.0;              // Mean of the exponential I/O burst lengths
+
+    std::vector<PriorityWeight> priorityMix = {{1, 1}, {2, 1}, {3, 1}, {4, 1}, {5, 1}};
+
+    /** Throws runtime error if any parameter is out of range. */
+    void validate() const;
+};
+
+/**
+ * Sets one generator parameter from its command-line name (without the leading dashes) and value:
+ * count, seed, arrivals (poisson|bursty), rate, burst-factor, burst-run, bursts (exponential|pareto|bimodal),
+ * mean-burst, pareto-shape, bimodal (SHORT:LONG:FRACTION), max-burst, priorities (P:W,P:W,...), io-fraction, io-bursts
+ * and mean-io.
+ * Returns false if name is not a generator parameter; throws runtime error on a malformed value.
+ */
+bool applyGeneratorOption(GeneratorConfig& config, const std::string& name, const std::string& value);
+
+/** Generates the whole workload in memory (IDs 1..processCount, sorted by arrival) on threadCount threads (0 = all cores). */
+std::vector<Process> generateWorkload(const GeneratorConfig& config, unsigned threadCount = 0);
+
+/**
+ * Generates a workload on the fly for the StreamingSimulationEngine or for writing out.
+ * Processes are produced a batch of blocks at a time, in parallel, so memory stays bounded by the batch size
+ * no matter how many processes are requested. The sequence is identical to generateWorkload.
+ */
+class GeneratedProcessStream : public ProcessStream {
+public:
+    explicit GeneratedProcessStream(const GeneratorConfig& config, unsigned threadCount = 0);
+
+    bool next(Process& process) override;
+    size_t count() const override { return produced; }
+
+private:
+    void generateBatch();
+
+    GeneratorConfig config;
+    unsigned threadCount;
+    uint64_t nextBlock;
+    double blockOffset;             // Arrival time at which nextBlock starts
+    std::vector<Process> batch;
+    size_t batchIdx;
+    size_t produced;
+};
+
+#endif
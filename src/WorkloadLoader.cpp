@@ -0,0 +1,360 @@
+#include "WorkloadLoader.h"
+#include "MappedFile.h"
+#include "BinaryWorkload.h"
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <charconv>
+#include <cstring>
+#include <thread>
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+/** Files smaller than this are always parsed on the calling thread. */
+static const size_t PARALLEL_PARSE_THRESHOLD = 8 << 20;
+
+static bool isTrimmed(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+/**
+ * Parses one comma-separated field with the same leniency as std::stoi: leading whitespace and a sign are
+ * accepted and anything after the digits is ignored. Returns an error message, or nullptr on success.
+ */
+static const char* parseField(const char* begin, const char* end, int& value) {
+    while (begin < end && isSpace(*begin)) ++begin;
+    if (begin < end && *begin == '+') {
+        ++begin;
+        if (begin == end || *begin < '0' || *begin > '9') return "Invalid integer format in line: ";
+    }
+    std::from_chars_result parsed = std::from_chars(begin, end, value);
+    if (parsed.ec == std::errc::invalid_argument) return "Invalid integer format in line: ";
+    if (parsed.ec == std::errc::result_out_of_range) return "Integer out of range in line: ";
+    return nullptr;
+}
+
+/**
+ * Parses the fields of a trimmed, non-comment line: the four process fields into values (the arrival time must not be
+ * negative and the burst time must be positive) and any further I/O, CPU, ... bursts into bursts (which must come in
+ * pairs and be positive).
+ * Fields are checked left to right before the field count, so errors match the order of the original
+ * getline/stoi parser; a single trailing comma does not produce an extra empty field.
+ * Returns false and fills error on failure.
+ */
+static bool parseValues(const char* begin, const char* end, int (&values)[4], std::vector<int>& bursts, std::string& error) {
+    size_t count = 0;
+    const char* field = begin;
+    bursts.clear();
+
+    while (field < end) {
+        const char* comma = static_cast<const char*>(std::memchr(field, ',', end - field));
+        const char* fieldEnd = comma ? comma : end;
+        int value = 0;
+        const char* message = parseField(field, fieldEnd, value);
+        if (message != nullptr) {
+            error = message + std::string(begin, end);
+            return false;
+        }
+        if (count < 4) values[count] = value;
+        else bursts.push_back(value);
+        count++;
+        if (comma == nullptr) break;
+        field = comma + 1;
+    }
+
+    if (count < 4 || bursts.size() % 2 != 0) {
+        error = "Incorrect number of values in line: " + std::string(begin, end) +
+                ". Expected format: ID,ArrivalTime,BurstTime,Priority[,IoBurst,CpuBurst]...";
+        return false;
+    }
+    if (values[1] < 0) {
+        error = "Arrival time must not be negative in line: " + std::string(begin, end);
+        return false;
+    }
+    if (values[2] < 1) {
+        error = "Burst time must be positive in line: " + std::string(begin, end);
+        return false;
+    }
+    for (int burst : bursts) {
+        if (burst < 1) {
+            error = "I/O and CPU bursts after the priority must be positive in line: " + std::string(begin, end);
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Parses a trimmed, non-comment line and appends the Process. Returns false and fills error on failure. */
+static bool parseLine(const char* begin, const char* end, std::vector<Process>& processes, std::string& error) {
+    int values[4] = {0, 0, 0, 0};
+    std::vector<int> bursts;
+    if (!parseValues(begin, end, values, bursts, error)) return false;
+    processes.emplace_back(values[0], values[1], values[2], values[3]);
+    if (!bursts.empty()) processes.back().ioCpuBursts = std::move(bursts);
+    return true;
+}
+
+/** Result of parsing one newline-aligned slice of the file. */
+struct ParsedChunk {
+    std::vector<Process> processes;
+    size_t lineCount = 0;  // Lines consumed (up to and including a failing line)
+    bool failed = false;
+    std::string error;
+};
+
+/** Parses every line in [begin, end), stopping at the first malformed line. */
+static void parseChunk(const char* begin, const char* end, ParsedChunk& chunk) {
+    // Reserve for the upper bound of one process per line
+    size_t newlines = std::count(begin, end, '\n');
+    chunk.processes.reserve(newlines + 1);
+
+    const char* line = begin;
+    while (line < end) {
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        const char* lineEnd = newline ? newline : end;
+        chunk.lineCount++;
+
+        const char* first = line;
+        const char* last = lineEnd;
+        while (first < last && isTrimmed(*first)) ++first;
+        while (last > first && isTrimmed(*(last - 1))) --last;
+
+        if (first < last && *first != '#') {
+            if (!parseLine(first, last, chunk.processes, chunk.error)) {
+                chunk.failed = true;
+                return;
+            }
+        }
+        line = lineEnd + 1;
+    }
+}
+
+Process parseProcessLine(const std::string& line) {
+    std::vector<Process> parsed;
+    std::string error;
+    if (!parseLine(line.data(), line.data() + line.size(), parsed, error)) {
+        throw std::runtime_error(error);
+    }
+    return parsed.front();
+}
+
+/** Parses an in-memory text workload, splitting it across threads when it is large enough. */
+static std::vector<Process> parseProcessText(const MappedFile& file, unsigned threadCount) {
+    const char* data = file.data();
+    const char* end = data + file.size();
+
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    if (file.size() < PARALLEL_PARSE_THRESHOLD) threadCount = 1;
+
+    // Split into roughly equal chunks, moving each boundary forward to just past a newline
+    std::vector<const char*> bounds(1, data);
+    for (unsigned i = 1; i < threadCount; ++i) {
+        const char* cut = std::max(bounds.back(), data + file.size() / threadCount * i);
+        const char* newline = static_cast<const char*>(std::memchr(cut, '\n', end - cut));
+        if (newline == nullptr) break;
+        bounds.push_back(newline + 1);
+    }
+    bounds.push_back(end);
+
+    std::vector<ParsedChunk> chunks(bounds.size() - 1);
+    if (chunks.size() == 1) {
+        parseChunk(data, end, chunks[0]);
+    } else {
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            workers.emplace_back(parseChunk, bounds[i], bounds[i + 1], std::ref(chunks[i]));
+        }
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    size_t total = 0;
+    size_t lineNumber = 0;
+    for (const ParsedChunk& chunk : chunks) {
+        if (chunk.failed) {
+            std::cerr << "Error parsing line " << lineNumber + chunk.lineCount << ": " << chunk.error << std::endl;
+            throw std::runtime_error(chunk.error);
+        }
+        lineNumber += chunk.lineCount;
+        total += chunk.processes.size();
+    }
+
+    if (chunks.size() == 1) return std::move(chunks[0].processes);
+
+    std::vector<Process> processes;
+    processes.reserve(total);
+    for (const ParsedChunk& chunk : chunks) {
+        processes.insert(processes.end(), chunk.processes.begin(), chunk.processes.end());
+    }
+    return processes;
+}
+
+std::vector<Process> loadProcessesFromFile(const std::string& filename, unsigned threadCount) {
+    MappedFile file(filename);
+    return parseProcessText(file, threadCount);
+}
+
+std::vector<Process> loadWorkload(const std::string& filename, unsigned threadCount) {
+    {
+        MappedFile file(filename);
+        if (!isBinaryWorkload(file.data(), file.size())) {
+            return parseProcessText(file, threadCount);
+        }
+    }
+    return loadBinaryWorkload(filename);
+}
+
+Workload loadWorkloadColumns(const std::string& filename, unsigned threadCount) {
+    {
+        MappedFile file(filename);
+        if (!isBinaryWorkload(file.data(), file.size())) {
+            return Workload(parseProcessText(file, threadCount));
+        }
+    }
+    return BinaryWorkloadView(filename).toWorkload();
+}
+
+/** Formats with to_chars into the caller's buffer; ostream formatting dominates for large workloads. */
+size_t formatProcessLine(const Process& process, char* buffer) {
+    char* end = buffer;
+    char* limit = buffer + processLineMax(process);
+    const int fields[4] = {process.id, process.arrivalTime, process.burstTime, process.priority};
+    for (int i = 0; i < 4; ++i) {
+        if (i > 0) *end++ = ',';
+        end = std::to_chars(end, limit, fields[i]).ptr;
+    }
+    for (int burst : process.ioCpuBursts) {
+        *end++ = ',';
+        end = std::to_chars(end, limit, burst).ptr;
+    }
+    *end++ = '\n';
+    return end - buffer;
+}
+
+void saveProcessesToFile(const std::string& filename, const std::vector<Process>& processes) {
+    std::ofstream outfile(filename, std::ios::trunc);
+    if (!outfile) {
+        throw std::runtime_error("Error opening file for writing: " + filename);
+    }
+
+    outfile << "# ProcessID,ArrivalTime,BurstTime,Priority[,IoBurst,CpuBurst]...\n";
+    std::vector<char> line(PROCESS_LINE_MAX);
+    for (const Process& p : processes) {
+        if (line.size() < processLineMax(p)) line.resize(processLineMax(p));
+        outfile.write(line.data(), formatProcessLine(p, line.data()));
+    }
+
+    if (!outfile) {
+        throw std::runtime_error("Error writing file: " + filename);
+    }
+}
+
+/** Bytes read from a text stream per read() call; the buffer only grows for a longer line. */
+static const size_t STREAM_BUFFER_SIZE = 1 << 20;
+
+WorkloadFileStream::WorkloadFileStream(const std::string& filename)
+    : filename(filename), fd(-1), begin(0), end(0), endOfInput(false), lineNumber(0), binaryIndex(0),
+      processCount(0), lastArrival(0) {
+    if (filename == "-") {
+        fd = STDIN_FILENO;
+    } else {
+        fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Error opening file: " + filename);
+    }
+    buffer.resize(STREAM_BUFFER_SIZE);
+
+    // A file starting with the binary magic is read column by column from a mapping instead
+    fill();
+    if (fd != STDIN_FILENO && isBinaryWorkload(buffer.data() + begin, end - begin)) {
+        ::close(fd);
+        fd = -1;
+        binary.reset(new BinaryWorkloadView(filename));
+    }
+}
+
+WorkloadFileStream::~WorkloadFileStream() {
+    if (fd >= 0 && fd != STDIN_FILENO) ::close(fd);
+}
+
+bool WorkloadFileStream::fill() {
+    if (begin > 0) {
+        std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+    }
+    if (end == buffer.size()) buffer.resize(buffer.size() * 2);
+
+    ssize_t bytesRead;
+    do {
+        bytesRead = ::read(fd, buffer.data() + end, buffer.size() - end);
+    } while (bytesRead < 0 && errno == EINTR);
+    if (bytesRead < 0) throw std::runtime_error("Error reading file: " + filename);
+    if (bytesRead == 0) endOfInput = true;
+    end += bytesRead;
+    return bytesRead > 0;
+}
+
+bool WorkloadFileStream::nextLine(const char*& lineBegin, const char*& lineEnd) {
+    while (true) {
+        const char* data = buffer.data();
+        const char* newline = static_cast<const char*>(std::memchr(data + begin, '\n', end - begin));
+        if (newline != nullptr) {
+            lineBegin = data + begin;
+            lineEnd = newline;
+            begin = newline - data + 1;
+            return true;
+        }
+        if (endOfInput || !fill()) {
+            if (begin == end) return false;
+            lineBegin = buffer.data() + begin; // Last line without a trailing newline
+            lineEnd = buffer.data() + end;
+            begin = end;
+            return true;
+        }
+    }
+}
+
+bool WorkloadFileStream::next(Process& process) {
+    if (binary) {
+        if (binaryIndex == binary->size()) return false;
+        size_t i = binaryIndex++;
+        process = Process(binary->ids()[i], binary->arrivalTimes()[i], binary->burstTimes()[i], binary->priorities()[i]);
+        if (binary->hasBursts()) process.ioCpuBursts.assign(binary->burstsOf(i), binary->burstsOf(i + 1));
+        checkOrder(process, "process " + std::to_string(binaryIndex));
+        return true;
+    }
+
+    const char* first;
+    const char* last;
+    while (nextLine(first, last)) {
+        lineNumber++;
+        while (first < last && isTrimmed(*first)) ++first;
+        while (last > first && isTrimmed(*(last - 1))) --last;
+        if (first == last || *first == '#') continue;
+
+        int values[4] = {0, 0, 0, 0};
+        std::string error;
+        if (!parseValues(first, last, values, lineBursts, error)) {
+            std::cerr << "Error parsing line " << lineNumber << ": " << error << std::endl;
+            throw std::runtime_error(error);
+        }
+        process = Process(values[0], values[1], values[2], values[3]);
+        if (!lineBursts.empty()) process.ioCpuBursts = lineBursts;
+        checkOrder(process, "line " + std::to_string(lineNumber));
+        return true;
+    }
+    return false;
+}
+
+void WorkloadFileStream::checkOrder(const Process& process, const std::string& location) {
+    if (processCount > 0 && process.arrivalTime < lastArrival) {
+        throw std::runtime_error("Process stream is not ordered by arrival time at " + location + " of " + filename);
+    }
+    lastArrival = process.arrivalTime;
+    processCount++;
+}
@@ -0,0 +1,101 @@
+#ifndef WORKLOAD_LOADER_H
+#define WORKLOAD_LOADER_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include "Process.h"
+#include "Workload.h"
+
+class BinaryWorkloadView;
+
+/**
+ * Parses a single line from the process input file.
+ * Expects a comma-separated string with format: ID,ArrivalTime,BurstTime,Priority, optionally followed by pairs
+ * of positive IoBurst,CpuBurst values for a process that alternates CPU and I/O bursts (see Process::ioCpuBursts).
+ * Converts these values to integers and constructs a Process object.
+ * Throws runtime error if parsing fails or the format is incorrect.
+ */
+Process parseProcessLine(const std::string& line);
+
+/**
+ * Loads process definitions from a specified file.
+ * The file is memory-mapped and scanned in place with std::from_chars, skipping empty lines and lines starting
+ * with '#' (comments in test file). Large files are split at newline boundaries and parsed on threadCount
+ * threads (0 picks the hardware concurrency). Throws runtime error if the file cannot be opened or if parsing
+ * fails, after reporting the offending line number on stderr.
+ */
+std::vector<Process> loadProcessesFromFile(const std::string& filename, unsigned threadCount = 0);
+
+/**
+ * Loads a workload in either supported format: binary workload files (see BinaryWorkload.h) are recognized by
+ * their magic bytes and mapped without parsing; anything else is parsed as the text format.
+ */
+std::vector<Process> loadWorkload(const std::string& filename, unsigned threadCount = 0);
+
+/**
+ * Loads a workload in either format straight into the columns the simulators read. Binary files skip the
+ * Process objects entirely and, when flagged as sorted, the sort as well.
+ */
+Workload loadWorkloadColumns(const std::string& filename, unsigned threadCount = 0);
+
+/**
+ * Formats one process as a text-format line (ID,ArrivalTime,BurstTime,Priority, its I/O and CPU bursts if any, and a
+ * newline) into buffer, which must hold at least processLineMax(process) bytes. Returns the number of bytes written.
+ */
+const size_t PROCESS_LINE_MAX = 48;
+inline size_t processLineMax(const Process& process) { return PROCESS_LINE_MAX + 12 * process.ioCpuBursts.size(); }
+size_t formatProcessLine(const Process& process, char* buffer);
+
+/** Writes processes in the text format (ID,ArrivalTime,BurstTime,Priority[,IoBurst,CpuBurst]...) with a header comment. Throws runtime error on I/O failure. */
+void saveProcessesToFile(const std::string& filename, const std::vector<Process>& processes);
+
+/** Source of processes in non-decreasing arrival order, consumed one process at a time (see StreamingSimulationEngine). */
+class ProcessStream {
+public:
+    virtual ~ProcessStream() {}
+
+    /** Reads the next process into process; returns false at the end of the stream. */
+    virtual bool next(Process& process) = 0;
+
+    /** Number of processes read so far. */
+    virtual size_t count() const = 0;
+};
+
+/**
+ * Reads an arrival-ordered workload one process at a time from a file, or from standard input when the file
+ * name is "-", so workloads far larger than memory can be simulated. Text is read through a fixed-size buffer
+ * with the same parser and error messages as loadProcessesFromFile; binary workload files are read from their
+ * mapping. Throws runtime error on malformed input or when arrival times decrease.
+ */
+class WorkloadFileStream : public ProcessStream {
+public:
+    explicit WorkloadFileStream(const std::string& filename);
+    ~WorkloadFileStream();
+
+    WorkloadFileStream(const WorkloadFileStream&) = delete;
+    WorkloadFileStream& operator=(const WorkloadFileStream&) = delete;
+
+    bool next(Process& process) override;
+    size_t count() const override { return processCount; }
+
+private:
+    bool fill();
+    bool nextLine(const char*& lineBegin, const char*& lineEnd);
+    void checkOrder(const Process& process, const std::string& location);
+
+    std::string filename;
+    int fd;
+    std::vector<char> buffer;
+    size_t begin;       // Start of the unconsumed bytes in buffer
+    size_t end;         // End of the valid bytes in buffer
+    bool endOfInput;
+    size_t lineNumber;
+    std::unique_ptr<BinaryWorkloadView> binary;
+    size_t binaryIndex;
+    size_t processCount;
+    int lastArrival;
+    std::vector<int> lineBursts; // Bursts after the priority on the current text line
+};
+
+#endif
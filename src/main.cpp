@@ -1,142 +1,408 @@
 #include <iostream>
-#include <fstream>
 #include <vector>
 #include <string>
-#include <sstream>
 #include <stdexcept>
+#include <iomanip>
+#include <functional>
+#include <future>
+#include <chrono>
+#include <utility>
+#include <algorithm>
+#include <thread>
+#include <memory>
 #include "Process.h"
 #include "Scheduler.h"
+#include "SimulationEngine.h"
+#include "WorkloadLoader.h"
+#include "ThreadPool.h"
+#include "ParameterSweep.h"
+#include "WorkloadGenerator.h"
+#include "TraceRecorder.h"
+#include "Replication.h"
+#include "CommandLine.h"
+
+/** A single scheduling algorithm run, deferred so it can be executed inline or on a thread pool. */
+typedef std::function<SimulationResult()> SimulationJob;
 
 /**
- * Parses a single line from the process input file.
- * Expects a comma-separated string with format: ID,ArrivalTime,BurstTime,Priority.
- * Converts these values to integers and constructs a Process object.
- * Throws runtime error if parsing fails or the format is incorrect.
+ * Prints the wall-clock time taken by each simulation and by the whole comparison.
+ * Rows follow the same order as the comparison table.
  */
-Process parseProcessLine(const std::string& line) {
-    std::stringstream ss(line);
-    std::string segment;
-    std::vector<int> values;
-
-    while (std::getline(ss, segment, ',')) {
-        try {
-            values.push_back(std::stoi(segment));
-        }
-        catch (const std::invalid_argument& e) {
-            throw std::runtime_error("Invalid integer format in line: " + line);
-        }
-        catch (const std::out_of_range& e) {
-            throw std::runtime_error("Integer out of range in line: " + line);
-        }
+void printTimings(const std::vector<SimulationResult>& results, const std::vector<double>& jobSeconds, double totalSeconds, size_t threadCount) {
+    std::cout << "\n--- Wall-Clock Time (" << threadCount << (threadCount == 1 ? " thread" : " threads") << ") ---" << std::endl;
+    std::cout << std::fixed << std::setprecision(6);
+    for (size_t i = 0; i < results.size(); ++i) {
+        std::cout << std::left << std::setw(45) << results[i].algorithmName << jobSeconds[i] << " s" << std::endl;
     }
+    std::cout << std::left << std::setw(45) << "Total" << totalSeconds << " s" << std::endl;
+}
 
-    if (values.size() != 4) {
-        throw std::runtime_error("Incorrect number of values in line: " + line + ". Expected format: ID,ArrivalTime,BurstTime,Priority");
+/** Prints one row of interim metrics from a streaming run, with a header before the first row. */
+void printSnapshot(const SimulationResult& snapshot, bool& headerPrinted) {
+    if (!headerPrinted) {
+        std::cout << "\n--- Interim Snapshots: " << snapshot.algorithmName << " ---" << std::endl;
+        std::cout << std::left << std::setw(12) << "Time"
+                  << std::setw(12) << "Completed"
+                  << std::setw(15) << "Avg Waiting"
+                  << std::setw(15) << "Avg Turnaround"
+                  << std::setw(15) << "Avg Response"
+                  << std::setw(15) << "CPU Util (%)"
+                  << std::setw(15) << "p99 Waiting"
+                  << std::setw(15) << "p99 Response"
+                  << std::endl;
+        headerPrinted = true;
     }
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(12) << snapshot.totalElapsedTime
+              << std::setw(12) << snapshot.totalProcessesCompleted
+              << std::setw(15) << snapshot.averageWaitingTime
+              << std::setw(15) << snapshot.averageTurnaroundTime
+              << std::setw(15) << snapshot.averageResponseTime
+              << std::setw(15) << snapshot.cpuUtilization
+              << std::setw(15) << snapshot.waitingPercentiles.p99
+              << std::setw(15) << snapshot.responsePercentiles.p99
+              << std::endl;
+}
 
-    return Process(values[0], values[1], values[2], values[3]);
+/**
+ * Writes the trace recorded for each result (traces[i] belongs to results[i]) as a Chrome trace-event file.
+ * Returns false and prints the error if the file cannot be written.
+ */
+bool writeTraceFile(const std::string& filename, const std::vector<SimulationResult>& results, const std::vector<std::unique_ptr<TraceRecorder>>& traces) {
+    std::vector<NamedTrace> runs;
+    size_t events = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        runs.push_back({results[i].algorithmName, traces[i].get()});
+        events += traces[i]->size();
+    }
+    try {
+        writeChromeTrace(filename, runs);
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Failed to write trace: " << e.what() << std::endl;
+        return false;
+    }
+    std::cout << "\nWrote " << events << " trace events to " << filename << " (open it in Perfetto or chrome://tracing)" << std::endl;
+    return true;
 }
 
 /**
- * Loads process definitions from a specified file.
- * Reads the file line by line, skipping empty lines and lines starting with '#' (comments in test file).
- * Uses parseProcessLine to convert each valid line into a Process object.
- * Throws runtime error if the file cannot be opened or if parsing fails.
+ * Builds the what-if scenario for one --what-if edit "ID:DELAY": a copy of workload in which process ID arrives DELAY
+ * time units later (earlier if DELAY is negative). Throws runtime error for a malformed edit or an unknown ID.
  */
-std::vector<Process> loadProcessesFromFile(const std::string& filename) {
-    std::ifstream infile(filename);
-    if (!infile) {
-        throw std::runtime_error("Error opening file: " + filename);
+WhatIfScenario delayedArrival(const Workload& workload, const std::string& edit) {
+    size_t colon = edit.find(':');
+    int id = 0;
+    int delay = 0;
+    try {
+        size_t idEnd = 0;
+        size_t delayEnd = 0;
+        if (colon == std::string::npos) throw std::invalid_argument(edit);
+        id = std::stoi(edit.substr(0, colon), &idEnd);
+        delay = std::stoi(edit.substr(colon + 1), &delayEnd);
+        if (idEnd != colon || delayEnd != edit.size() - colon - 1) throw std::invalid_argument(edit);
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Expected --what-if ID:DELAY, got \"" + edit + "\"");
     }
 
     std::vector<Process> processes;
-    std::string line;
-    int lineNumber = 0;
-    while (std::getline(infile, line)) {
-        lineNumber++;
-        line.erase(0, line.find_first_not_of(" \t\n\r"));
-        line.erase(line.find_last_not_of(" \t\n\r") + 1);
-
-        if (line.empty() || line[0] == '#') { 
-            continue;
-        }
-
-        try {
-            processes.push_back(parseProcessLine(line));
-        } catch (const std::runtime_error& e) {
-            std::cerr << "Error parsing line " << lineNumber << ": " << e.what() << std::endl;
-            throw; 
+    processes.reserve(workload.size());
+    bool found = false;
+    for (size_t slot = 0; slot < workload.size(); ++slot) {
+        processes.push_back(workload.process(slot));
+        if (processes.back().id == id) {
+            processes.back().arrivalTime += delay;
+            found = true;
         }
     }
+    if (!found) throw std::runtime_error("--what-if: no process with ID " + std::to_string(id));
+    return {"P" + std::to_string(id) + (delay < 0 ? " " : " +") + std::to_string(delay), Workload(std::move(processes))};
+}
 
-    infile.close();
-    return processes;
+/** The algorithms of the comparison, in table order, as policies of a Monte Carlo study. */
+std::vector<ReplicaPolicy> replicaPolicies(int timeQuantum, const MlfqConfig& mlfqConfig, const CfsParameters& cfsParameters,
+                                           const SimulationOptions& options) {
+    return {
+        [options](const Workload& w) { return runFCFS(w, options); },
+        [options](const Workload& w) { return runSJF(w, options); },
+        [options](const Workload& w) { return runSRTF(w, options); },
+        [options](const Workload& w) { return runPriority(w, false, options); },
+        [options](const Workload& w) { return runPriority(w, true, options); },
+        [timeQuantum, options](const Workload& w) { return runRoundRobin(w, timeQuantum, options); },
+        [mlfqConfig, options](const Workload& w) { return runMLFQ(w, mlfqConfig, options); },
+        [cfsParameters, options](const Workload& w) { return runCFS(w, cfsParameters, options); }
+    };
 }
 
 /**
  * Main entry point for the CPU scheduling simulator.
- * Handles command-line arguments to get the input process file path.
- * Loads the process definitions using loadProcessesFromFile.
- * Runs simulations for various scheduling algorithms (FCFS, SJF, SRTF, Priority, RR, MLFQ).
- * Collects the results from each simulation.
- * Prints a comparative table of the performance metrics for all algorithms.
+ * The command line is read by parseCommandLine and checked by CommandLineOptions::validate (see CommandLine.h), which
+ * also decides the run mode: the input process file path, the optional --jobs N thread count, an optional MLFQ
+ * configuration file (--mlfq-config) and the optional parameter sweep lists (--sweep, --rr-quantum, --mlfq-q0,
+ * --mlfq-q1, --mlfq-aging).
+ * With --generate the workload is produced by the synthetic generator (configured with its --count, --seed, ...
+ * options) instead of being read from a file.
+ * With --stream ALGORITHM the file (or "-" for standard input) is read incrementally and simulated by a single
+ * algorithm in bounded memory, printing interim metrics every --snapshot-interval time units.
+ * With --cpus N the comparison runs every algorithm on N simulated CPUs with per-CPU ready queues and work stealing
+ * (each migration costing --migration-cost time units) and adds per-CPU utilization and load imbalance.
+ * --switch-cost and --preemption-cost charge each context switch (a different process taking the CPU) to simulated time.
+ * Processes with I/O bursts block on one of --io-devices identical I/O devices (default 1) between their CPU bursts.
+ * With --stats (in builds configured with -DSCHEDULER_STATS=ON) each run also reports its own cost: wall time, ticks,
+ * ready-queue operations and scan length, allocations and peak ready-queue depth.
+ * With --trace FILE every run records its scheduling events into a ring buffer of --trace-capacity events, and the
+ * timelines are written as a Chrome trace-event file.
+ * Each --what-if ID:DELAY compares every algorithm against a copy of the workload in which that process arrives DELAY
+ * units later; the baseline keeps a checkpoint every --checkpoint-interval units (by default 1/32 of the arrival span)
+ * and each scenario is re-simulated only from the last checkpoint before the change.
+ * With --replicas K every algorithm runs on K random workloads (bootstrap resamples of the file, workloads generated
+ * from a model fitted to it with --replica-model fit, or generated workloads with --generate), all derived from
+ * --seed, and the metrics are reported as means with 95% confidence intervals.
+ * Loads the process definitions using loadWorkload, which accepts both the text and the binary workload format.
+ * Runs simulations for various scheduling algorithms (FCFS, SJF, SRTF, Priority, RR, MLFQ, CFS), one after another
+ * or, with --jobs, concurrently on a thread pool where each algorithm is an independent task.
+ * Collects the results from each simulation in a fixed order.
+ * Prints a comparative table of the performance metrics for all algorithms, plus wall-clock timings in --jobs mode.
+ * In sweep mode, runs every RR quantum and MLFQ parameter combination instead and prints the table with its Pareto frontier.
  */
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <process_file.txt>" << std::endl;
+    CommandLineOptions cli;
+    try {
+        cli = parseCommandLine(argc, argv);
+    } catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
         return 1;
     }
+    try {
+        cli.validate();
+    } catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+    const SimulationOptions& options = cli.simulation;
+    const MlfqConfig& mlfqConfig = cli.mlfqConfig;
+    const CfsParameters& cfsParameters = cli.cfsParameters;
+    const GeneratorConfig& generatorConfig = cli.generatorConfig;
+    const std::string& filename = cli.filename;
+    int jobs = cli.jobs;
+    RunMode mode = cli.mode();
 
-    std::string filename = argv[1];
-    std::vector<Process> processes;
+    // Round Robin quantum of the comparison, the what-if runs and the Monte Carlo study alike
+    int timeQuantum = 4;
+
+    if (mode == RunMode::Stream) {
+        // Processes are read while the simulation runs, so the input must already be ordered by arrival time
+        try {
+            std::unique_ptr<ProcessStream> stream;
+            if (cli.generate) stream.reset(new GeneratedProcessStream(generatorConfig, jobs));
+            else stream.reset(new WorkloadFileStream(filename));
+            std::vector<std::unique_ptr<TraceRecorder>> traces;
+            if (!cli.traceFile.empty()) traces.emplace_back(new TraceRecorder(cli.traceCapacity));
+            SimulationOptions streamOptions = options;
+            streamOptions.trace = traces.empty() ? nullptr : traces[0].get();
+            bool headerPrinted = false;
+            SimulationResult result = runStreaming(*stream, cli.streamAlgorithm, cli.sweepConfig.roundRobinQuanta.front(), mlfqConfig, cli.snapshotInterval,
+                                                   [&headerPrinted](const SimulationResult& snapshot) { printSnapshot(snapshot, headerPrinted); },
+                                                   cfsParameters, streamOptions);
+            std::cout << "\nStreamed " << stream->count() << " processes from " << (cli.generate ? "the workload generator" : filename) << std::endl;
+            printComparison({result});
+            printIoSummary({result});
+            if (cli.showStats) printEngineStats({result});
+            if (!traces.empty() && !writeTraceFile(cli.traceFile, {result}, traces)) return 1;
+        } catch (const std::runtime_error& e) {
+            std::cerr << "Streaming simulation failed: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (mode == RunMode::Replicas) {
+        ReplicationConfig replication;
+        replication.replicas = cli.replicas;
+        replication.seed = generatorConfig.seed;
+        std::unique_ptr<Workload> source;
+        try {
+            if (cli.generate) {
+                replication.model = ReplicaModel::Generate;
+                replication.generator = generatorConfig;
+                std::cout << "Monte Carlo study: " << cli.replicas << " generated workloads of " << generatorConfig.processCount << " processes";
+            } else {
+                source.reset(new Workload(loadWorkloadColumns(filename)));
+                if (source->size() == 0) throw std::runtime_error("No valid processes found in " + filename);
+                std::cout << "Successfully loaded " << source->size() << " processes from " << filename << std::endl;
+                if (cli.fitModel) {
+                    replication.model = ReplicaModel::Generate;
+                    replication.generator = fitGeneratorConfig(*source);
+                    std::cout << "Fitted model: Poisson arrivals at rate " << replication.generator.arrivalRate
+                              << ", exponential CPU bursts with mean " << replication.generator.meanBurst
+                              << ", " << replication.generator.priorityMix.size() << " priority levels";
+                    if (replication.generator.ioFraction > 0) {
+                        std::cout << ", I/O in " << replication.generator.ioFraction * 100 << "% of processes";
+                    }
+                    std::cout << std::endl;
+                    std::cout << "Monte Carlo study: " << cli.replicas << " workloads generated from the fitted model";
+                } else {
+                    replication.model = ReplicaModel::Resample;
+                    replication.source = source.get();
+                    std::cout << "Monte Carlo study: " << cli.replicas << " bootstrap resamples of the workload";
+                }
+            }
+            std::cout << " (seed " << replication.seed << ")" << std::endl;
+
+            ThreadPool pool(jobs > 0 ? jobs : std::max(1u, std::thread::hardware_concurrency()));
+            printReplicatedResults(runReplicas(replication, replicaPolicies(timeQuantum, mlfqConfig, cfsParameters, options), pool));
+        } catch (const std::runtime_error& e) {
+            std::cerr << "Monte Carlo study failed: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // Sorted and split into columns once; every run below reads it and only allocates its own run state
+    Workload workload;
 
     try {
-        processes = loadProcessesFromFile(filename);
-        std::cout << "Successfully loaded " << processes.size() << " processes from " << filename << std::endl;
+        if (cli.generate) {
+            workload = Workload(generateWorkload(generatorConfig, jobs));
+            std::cout << "Generated " << workload.size() << " processes (seed " << generatorConfig.seed << ")" << std::endl;
+        } else {
+            workload = loadWorkloadColumns(filename);
+            std::cout << "Successfully loaded " << workload.size() << " processes from " << filename << std::endl;
+        }
     } catch (const std::runtime_error& e) {
         std::cerr << "Failed to load processes: " << e.what() << std::endl;
         return 1;
     }
 
-    if (processes.empty()) {
+    if (workload.size() == 0) {
         std::cerr << "No valid processes found in the file." << std::endl;
         return 1;
     }
 
-    
-    std::vector<SimulationResult> allResults;
+    if (mode == RunMode::Sweep) {
+        ThreadPool pool(jobs > 0 ? jobs : std::max(1u, std::thread::hardware_concurrency()));
+        SweepConfig sweepConfig = cli.sweepConfig;
+        sweepConfig.contextSwitch = options.contextSwitch;
+        sweepConfig.ioDevices = options.ioDevices;
+        printSweepResults(runParameterSweep(workload, sweepConfig, pool));
+        return 0;
+    }
+
+    const char* algorithms[] = {"fcfs", "sjf", "srtf", "priority", "priority-preemptive", "rr", "mlfq", "cfs"};
 
-    
-    std::vector<Process> fcfsProcesses = processes;
-    allResults.push_back(runFCFS(fcfsProcesses));
+    if (mode == RunMode::WhatIf) {
+        std::vector<WhatIfScenario> scenarios;
+        try {
+            for (const std::string& edit : cli.whatIfEdits) scenarios.push_back(delayedArrival(workload, edit));
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        int checkpointInterval = cli.checkpointInterval > 0 ? cli.checkpointInterval : std::max(1, workload.arrivalTimes.back() / 32);
+        std::cout << "Checkpoint interval: " << checkpointInterval << " time units" << std::endl;
 
-    
-    std::vector<Process> sjfProcesses = processes;
-    allResults.push_back(runSJF(sjfProcesses));
+        // Every algorithm keeps its own checkpoints, so the algorithms run as independent tasks
+        std::vector<WhatIfRun> runs;
+        std::vector<SimulationResult> results;
+        ThreadPool pool(jobs > 0 ? jobs : 1);
+        std::vector<std::future<std::vector<WhatIfRun>>> pending;
+        for (const char* algorithm : algorithms) {
+            pending.push_back(pool.submit([&, algorithm] {
+                return runWhatIf(workload, scenarios, algorithm, timeQuantum, mlfqConfig, checkpointInterval, cfsParameters, options);
+            }));
+        }
+        try {
+            for (auto& future : pending) {
+                for (WhatIfRun& run : future.get()) {
+                    results.push_back(run.result);
+                    runs.push_back(run);
+                }
+            }
+        } catch (const std::runtime_error& e) {
+            std::cerr << "What-if simulation failed: " << e.what() << std::endl;
+            return 1;
+        }
+        printComparison(results);
+        printIoSummary(results);
+        printResimulation(runs);
+        return 0;
+    }
 
-    
-    std::vector<Process> srtfProcesses = processes;
-    allResults.push_back(runSRTF(srtfProcesses));
+    // Jobs share the read-only workload, so they are fully independent of each other; each traced job has its own buffer
+    std::vector<std::unique_ptr<TraceRecorder>> traces;
+    if (!cli.traceFile.empty()) {
+        for (size_t i = 0; i < sizeof(algorithms) / sizeof(algorithms[0]); ++i) traces.emplace_back(new TraceRecorder(cli.traceCapacity));
+    }
+    auto jobOptions = [&options, &traces](size_t job) {
+        SimulationOptions jobOptions = options;
+        jobOptions.trace = traces.empty() ? nullptr : traces[job].get();
+        return jobOptions;
+    };
 
-    
-    std::vector<Process> priorityNPProcesses = processes;
-    allResults.push_back(runPriority(priorityNPProcesses, false));
+    std::vector<SimulationJob> simulationJobs;
+    if (cli.multiCoreSet) {
+        for (size_t i = 0; i < sizeof(algorithms) / sizeof(algorithms[0]); ++i) {
+            const char* algorithm = algorithms[i];
+            SimulationOptions runOptions = jobOptions(i);
+            simulationJobs.push_back([&workload, algorithm, timeQuantum, &mlfqConfig, &cli, &cfsParameters, runOptions] {
+                return runMultiCore(workload, algorithm, timeQuantum, mlfqConfig, cli.multiCore, cfsParameters, runOptions);
+            });
+        }
+    } else {
+        simulationJobs = {
+            [&workload, jobOptions] { return runFCFS(workload, jobOptions(0)); },
+            [&workload, jobOptions] { return runSJF(workload, jobOptions(1)); },
+            [&workload, jobOptions] { return runSRTF(workload, jobOptions(2)); },
+            [&workload, jobOptions] { return runPriority(workload, false, jobOptions(3)); },
+            [&workload, jobOptions] { return runPriority(workload, true, jobOptions(4)); },
+            [&workload, timeQuantum, jobOptions] { return runRoundRobin(workload, timeQuantum, jobOptions(5)); },
+            [&workload, &mlfqConfig, jobOptions] { return runMLFQ(workload, mlfqConfig, jobOptions(6)); },
+            [&workload, &cfsParameters, jobOptions] { return runCFS(workload, cfsParameters, jobOptions(7)); }
+        };
+    }
 
-    
-    std::vector<Process> priorityPProcesses = processes;
-    allResults.push_back(runPriority(priorityPProcesses, true));
+    std::vector<SimulationResult> allResults;
 
-    
-    std::vector<Process> rrProcesses = processes;
-    int timeQuantum = 4; 
-    allResults.push_back(runRoundRobin(rrProcesses, timeQuantum));
+    if (jobs == 0) {
+        for (const SimulationJob& job : simulationJobs) {
+            allResults.push_back(job());
+        }
+        printComparison(allResults);
+        printIoSummary(allResults);
+        printCoreUtilization(allResults);
+        if (cli.showStats) printEngineStats(allResults);
+        if (!traces.empty() && !writeTraceFile(cli.traceFile, allResults, traces)) return 1;
+        return 0;
+    }
 
-    
-    std::vector<Process> mlfqProcesses = processes;
-    allResults.push_back(runMLFQ(mlfqProcesses));
+    typedef std::chrono::steady_clock Clock;
+    std::vector<double> jobSeconds;
+    Clock::time_point totalStart = Clock::now();
+    {
+        ThreadPool pool(jobs);
+        std::vector<std::future<std::pair<SimulationResult, double>>> pending;
+        for (const SimulationJob& job : simulationJobs) {
+            pending.push_back(pool.submit([&job] {
+                Clock::time_point start = Clock::now();
+                SimulationResult result = job();
+                return std::make_pair(result, std::chrono::duration<double>(Clock::now() - start).count());
+            }));
+        }
+        // Futures are collected in submission order, so the table order does not depend on thread timing
+        for (auto& future : pending) {
+            std::pair<SimulationResult, double> run = future.get();
+            allResults.push_back(run.first);
+            jobSeconds.push_back(run.second);
+        }
+    }
+    double totalSeconds = std::chrono::duration<double>(Clock::now() - totalStart).count();
 
-    
     printComparison(allResults);
+    printIoSummary(allResults);
+    printCoreUtilization(allResults);
+    printTimings(allResults, jobSeconds, totalSeconds, jobs);
+    if (cli.showStats) printEngineStats(allResults);
+    if (!traces.empty() && !writeTraceFile(cli.traceFile, allResults, traces)) return 1;
 
     return 0;
-} 
\ No newline at end of file
+}
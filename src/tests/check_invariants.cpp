@@ -0,0 +1,238 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include "../Process.h"
+#include "../Scheduler.h"
+#include "../SimulationEngine.h"
+#include "../MlfqConfig.h"
+#include "../TraceRecorder.h"
+#include "../WorkloadLoader.h"
+#include "../BinaryWorkload.h"
+#include "../WorkloadGenerator.h"
+
+/** Algorithm names accepted by runStreaming, runMultiCore and runWhatIf. */
+static const char* const ALGORITHMS[] = {"fcfs", "sjf", "srtf", "priority", "priority-preemptive", "rr", "mlfq", "cfs"};
+static const int TIME_QUANTUM = 4;
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+/** Runs algorithm through its own runX entry point: the single-CPU, in-memory reference for the other engines. */
+static SimulationResult runSingle(const Workload& workload, const std::string& algorithm, const MlfqConfig& mlfqConfig,
+                                  const SimulationOptions& options) {
+    if (algorithm == "fcfs") return runFCFS(workload, options);
+    if (algorithm == "sjf") return runSJF(workload, options);
+    if (algorithm == "srtf") return runSRTF(workload, options);
+    if (algorithm == "priority") return runPriority(workload, false, options);
+    if (algorithm == "priority-preemptive") return runPriority(workload, true, options);
+    if (algorithm == "rr") return runRoundRobin(workload, TIME_QUANTUM, options);
+    if (algorithm == "mlfq") return runMLFQ(workload, mlfqConfig, options);
+    if (algorithm == "cfs") return runCFS(workload, CfsParameters(), options);
+    throw std::runtime_error("Unknown algorithm: " + algorithm);
+}
+
+static bool samePercentiles(const LatencyPercentiles& a, const LatencyPercentiles& b) {
+    return a.p50 == b.p50 && a.p90 == b.p90 && a.p99 == b.p99 && a.p999 == b.p999 && a.max == b.max;
+}
+
+/** True if two runs scheduled the workload identically: every metric except the engine's event count and the name. */
+static bool sameSchedule(const SimulationResult& a, const SimulationResult& b) {
+    return a.averageWaitingTime == b.averageWaitingTime && a.averageTurnaroundTime == b.averageTurnaroundTime &&
+           a.averageResponseTime == b.averageResponseTime && a.cpuUtilization == b.cpuUtilization &&
+           a.throughput == b.throughput && a.totalElapsedTime == b.totalElapsedTime &&
+           a.totalProcessesCompleted == b.totalProcessesCompleted &&
+           samePercentiles(a.waitingPercentiles, b.waitingPercentiles) &&
+           samePercentiles(a.turnaroundPercentiles, b.turnaroundPercentiles) &&
+           samePercentiles(a.responsePercentiles, b.responsePercentiles) && a.contextSwitches == b.contextSwitches &&
+           a.preemptions == b.preemptions && a.contextSwitchTime == b.contextSwitchTime && a.ioRequests == b.ioRequests &&
+           a.ioUtilization == b.ioUtilization && a.ioWaitTime == b.ioWaitTime;
+}
+
+static bool sameWorkload(const Workload& a, const Workload& b) {
+    return a.ids == b.ids && a.arrivalTimes == b.arrivalTimes && a.burstTimes == b.burstTimes &&
+           a.priorities == b.priorities && a.burstOffsets == b.burstOffsets && a.bursts == b.bursts;
+}
+
+static bool sameProcesses(const std::vector<Process>& a, const std::vector<Process>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].id != b[i].id || a[i].arrivalTime != b[i].arrivalTime || a[i].burstTime != b[i].burstTime ||
+            a[i].priority != b[i].priority || a[i].ioCpuBursts != b[i].ioCpuBursts) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Streaming the workload from a text file gives the same schedule as running it in memory. */
+static void checkStreaming(const std::string& name, const Workload& workload, const MlfqConfig& mlfqConfig,
+                           const SimulationOptions& options) {
+    std::vector<Process> processes;
+    for (size_t slot = 0; slot < workload.size(); ++slot) processes.push_back(workload.process(slot));
+    std::string file = "check_stream.txt";
+    saveProcessesToFile(file, processes);
+
+    for (const char* algorithm : ALGORITHMS) {
+        WorkloadFileStream stream(file);
+        SimulationResult streamed = runStreaming(stream, algorithm, TIME_QUANTUM, mlfqConfig, 0, nullptr, CfsParameters(), options);
+        check(sameSchedule(streamed, runSingle(workload, algorithm, mlfqConfig, options)),
+              name + ": streamed " + algorithm + " differs from the in-memory run");
+    }
+}
+
+/** The multi-CPU engine with one CPU gives the same schedule as the single-CPU engine. */
+static void checkOneCore(const std::string& name, const Workload& workload, const MlfqConfig& mlfqConfig,
+                         const SimulationOptions& options) {
+    MultiCoreConfig oneCore;
+    oneCore.cores = 1;
+    for (const char* algorithm : ALGORITHMS) {
+        SimulationResult multi = runMultiCore(workload, algorithm, TIME_QUANTUM, mlfqConfig, oneCore, CfsParameters(), options);
+        check(sameSchedule(multi, runSingle(workload, algorithm, mlfqConfig, options)),
+              name + ": " + algorithm + " on one of the multi-CPU engine's CPUs differs from the single-CPU run");
+    }
+}
+
+/** A what-if scenario resumed from a checkpoint gives the same schedule as a full run of the edited workload. */
+static void checkWhatIf(const std::string& name, const Workload& workload, const MlfqConfig& mlfqConfig,
+                        const SimulationOptions& options) {
+    // Delay the process in the middle of the arrival order, so the scenario resumes from a later checkpoint
+    size_t delayed = workload.size() / 2;
+    std::vector<Process> processes;
+    for (size_t slot = 0; slot < workload.size(); ++slot) processes.push_back(workload.process(slot));
+    processes[delayed].arrivalTime += 7;
+    WhatIfScenario scenario = {"delayed", Workload(processes)};
+    int checkpointInterval = std::max(1, workload.arrivalTimes.back() / 8);
+
+    for (const char* algorithm : ALGORITHMS) {
+        std::vector<WhatIfRun> runs = runWhatIf(workload, {scenario}, algorithm, TIME_QUANTUM, mlfqConfig, checkpointInterval,
+                                                CfsParameters(), options);
+        check(runs.size() == 2 && sameSchedule(runs[0].result, runSingle(workload, algorithm, mlfqConfig, options)),
+              name + ": what-if baseline of " + algorithm + " differs from a full run");
+        check(runs.size() == 2 && sameSchedule(runs[1].result, runSingle(scenario.workload, algorithm, mlfqConfig, options)),
+              name + ": what-if rerun of " + algorithm + " differs from a full run of the edited workload");
+    }
+}
+
+/** Writing a workload in the binary format and loading it again gives back the same columns and processes. */
+static void checkBinaryRoundTrip(const std::string& name, const Workload& workload) {
+    std::vector<Process> processes;
+    for (size_t slot = 0; slot < workload.size(); ++slot) processes.push_back(workload.process(slot));
+    std::string file = "check_round_trip.bin";
+
+    saveBinaryWorkload(file, processes);
+    check(sameWorkload(loadWorkloadColumns(file), workload), name + ": binary round trip (sorted) changed the workload");
+    check(sameProcesses(loadWorkload(file), processes), name + ": binary round trip changed the processes");
+
+    // Reversed, the file is written without the sorted flag and must be sorted again on loading
+    std::vector<Process> reversed(processes.rbegin(), processes.rend());
+    saveBinaryWorkload(file, reversed);
+    check(sameWorkload(loadWorkloadColumns(file), workload), name + ": binary round trip (unsorted) changed the workload");
+    check(sameProcesses(loadWorkload(file), reversed), name + ": binary round trip kept the processes out of file order");
+}
+
+/** The generator's output depends on the seed only, not on the number of threads or on streaming. */
+static void checkGenerator() {
+    GeneratorConfig config;
+    config.processCount = 200000; // Several generator blocks, so threads really split the work
+    config.seed = 7;
+    config.ioFraction = 0.2;
+
+    std::vector<Process> reference = generateWorkload(config, 1);
+    for (unsigned threads : {2u, 3u, 8u}) {
+        check(sameProcesses(generateWorkload(config, threads), reference),
+              "generator output with " + std::to_string(threads) + " threads differs from one thread");
+    }
+
+    GeneratedProcessStream stream(config, 3);
+    std::vector<Process> streamed;
+    Process process(0, 0, 0, 0);
+    while (stream.next(process)) streamed.push_back(process);
+    check(sameProcesses(streamed, reference), "streamed generator output differs from generateWorkload");
+}
+
+/**
+ * Regression input for MLFQ aging with one-level boosts (src/tests/mlfq_boost_up.*): P2 waits in Q1 and is due
+ * a boost at 28, but its level was scanned while empty before the boost of P1. Computing the aging deadline too
+ * early postponed the boost to P3's arrival at 30.
+ */
+static void checkMlfqBoostDeadline(const std::string& directory) {
+    MlfqConfig config = loadMlfqConfigFromFile(directory + "/mlfq_boost_up.cfg");
+    Workload workload(loadWorkload(directory + "/mlfq_boost_up.txt"));
+    TraceRecorder trace;
+    SimulationOptions options;
+    options.trace = &trace;
+    runMLFQ(workload, config, options);
+
+    int boostTime = -1;
+    for (size_t i = 0; i < trace.size() && boostTime < 0; ++i) {
+        const TraceEvent& event = trace[i];
+        if (event.type == TraceEventType::Boost && event.processId == 2 && event.detail == 0) boostTime = event.time;
+    }
+    check(boostTime == 28, "mlfq_boost_up: P2 boosted to Q0 at " + std::to_string(boostTime) + ", expected 28");
+}
+
+/**
+ * Checks invariants between the engines and the workload formats that every change must keep:
+ * streaming equals in-memory runs, one CPU of the multi-CPU engine equals the single-CPU engine, what-if reruns
+ * equal full runs, binary files round-trip, and the generator is deterministic across thread counts.
+ * Takes the directory holding the test inputs (src/tests); temporary files go to the working directory.
+ */
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <test_input_directory>" << std::endl;
+        return 1;
+    }
+    std::string directory = argv[1];
+
+    try {
+        MlfqConfig mlfqConfig = MlfqConfig::fromParameters(MlfqParameters());
+        MlfqConfig fourLevels = loadMlfqConfigFromFile(directory + "/mlfq_4level.cfg");
+
+        GeneratorConfig generated;
+        generated.processCount = 3000;
+        generated.ioFraction = 0.3;
+        std::vector<std::pair<std::string, Workload>> workloads;
+        workloads.emplace_back("generated", Workload(generateWorkload(generated)));
+        for (const char* input : {"basic_test.txt", "arrival0.txt", "burst_mix.txt", "large_scale.txt", "mlfq_boost_up.txt"}) {
+            workloads.emplace_back(input, Workload(loadWorkload(directory + "/" + input)));
+        }
+
+        // Free switches and one I/O device, then both switch costs and two devices
+        SimulationOptions costly;
+        costly.contextSwitch.voluntary = 1;
+        costly.contextSwitch.preemption = 2;
+        costly.ioDevices = 2;
+
+        for (const auto& entry : workloads) {
+            for (const SimulationOptions& options : {SimulationOptions(), costly}) {
+                for (const MlfqConfig* mlfq : {&mlfqConfig, &fourLevels}) {
+                    checkStreaming(entry.first, entry.second, *mlfq, options);
+                    checkOneCore(entry.first, entry.second, *mlfq, options);
+                    checkWhatIf(entry.first, entry.second, *mlfq, options);
+                }
+            }
+            checkBinaryRoundTrip(entry.first, entry.second);
+        }
+        checkGenerator();
+        checkMlfqBoostDeadline(directory);
+    } catch (const std::exception& e) {
+        std::cerr << "Invariant checks failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (failures > 0) {
+        std::cerr << failures << " invariant checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All invariant checks passed" << std::endl;
+    return 0;
+}
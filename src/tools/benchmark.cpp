@@ -0,0 +1,232 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <stdexcept>
+#include <algorithm>
+#include <sys/resource.h>
+#include "../Process.h"
+#include "../Scheduler.h"
+#include "../SimulationEngine.h"
+#include "../ParameterSweep.h"
+#include "../WorkloadGenerator.h"
+
+/** One policy as the benchmark runs it: a display name and a call into the public runX API. */
+struct BenchmarkPolicy {
+    std::string name;
+    std::function<SimulationResult(const Workload&)> run;
+};
+
+/** Measurements for one policy on one workload size (the fastest of the repetitions). */
+struct BenchmarkResult {
+    std::string policy;
+    size_t processes;
+    long long events;
+    double seconds;
+    long peakRssKb;
+    SimulationResult metrics;
+};
+
+/** Resets the peak resident set size of this process (Linux clear_refs); a no-op where unsupported. */
+static void resetPeakRss() {
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (clearRefs) clearRefs << "5";
+}
+
+/** Peak resident set size in KiB since the last reset, from /proc/self/status or getrusage as a fallback. */
+static long peakRssKb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return std::stol(line.substr(6));
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/** The same policies on the multi-CPU engine. */
+static std::vector<BenchmarkPolicy> multiCorePolicies(const MultiCoreConfig& multiCore) {
+    const char* algorithms[][2] = {{"fcfs", "FCFS"}, {"sjf", "SJF"}, {"srtf", "SRTF"}, {"priority", "Priority"},
+                                   {"priority-preemptive", "Priority (Preemptive)"}, {"rr", "RR (Quantum=4)"}, {"mlfq", "MLFQ"}, {"cfs", "CFS"}};
+    MlfqConfig mlfqConfig = MlfqConfig::fromParameters(MlfqParameters());
+    std::vector<BenchmarkPolicy> policies;
+    for (const auto& algorithm : algorithms) {
+        std::string name = std::string(algorithm[1]) + " x" + std::to_string(multiCore.cores);
+        std::string key = algorithm[0];
+        policies.push_back({name, [key, mlfqConfig, multiCore](const Workload& w) { return runMultiCore(w, key, 4, mlfqConfig, multiCore); }});
+    }
+    return policies;
+}
+
+static std::vector<BenchmarkPolicy> benchmarkPolicies() {
+    return {
+        {"FCFS", [](const Workload& w) { return runFCFS(w); }},
+        {"SJF", [](const Workload& w) { return runSJF(w); }},
+        {"SRTF", [](const Workload& w) { return runSRTF(w); }},
+        {"Priority", [](const Workload& w) { return runPriority(w, false); }},
+        {"Priority (Preemptive)", [](const Workload& w) { return runPriority(w, true); }},
+        {"RR (Quantum=4)", [](const Workload& w) { return runRoundRobin(w, 4); }},
+        {"MLFQ", [](const Workload& w) { return runMLFQ(w); }},
+        {"CFS", [](const Workload& w) { return runCFS(w); }}
+    };
+}
+
+/** Runs a policy repetitions times and keeps the fastest run; the peak RSS covers all repetitions. */
+static BenchmarkResult measure(const BenchmarkPolicy& policy, const Workload& processes, int repetitions) {
+    typedef std::chrono::steady_clock Clock;
+    BenchmarkResult result;
+    result.policy = policy.name;
+    result.processes = processes.size();
+    result.seconds = -1;
+
+    resetPeakRss();
+    for (int i = 0; i < repetitions; ++i) {
+        Clock::time_point start = Clock::now();
+        SimulationResult metrics = policy.run(processes);
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (result.seconds < 0 || seconds < result.seconds) {
+            result.seconds = seconds;
+            result.metrics = metrics;
+        }
+    }
+    result.events = result.metrics.eventCount;
+    result.peakRssKb = peakRssKb();
+    return result;
+}
+
+static void printHeader() {
+    std::cout << std::left << std::setw(28) << "Policy"
+              << std::setw(12) << "Processes"
+              << std::setw(14) << "Events"
+              << std::setw(12) << "Time (s)"
+              << std::setw(14) << "Events/s"
+              << std::setw(12) << "ns/process"
+              << std::setw(14) << "Peak RSS (MB)"
+              << std::endl;
+    std::cout << std::string(106, '-') << std::endl;
+}
+
+static void printRow(const BenchmarkResult& r) {
+    std::cout << std::left << std::setw(28) << r.policy
+              << std::setw(12) << r.processes
+              << std::setw(14) << r.events
+              << std::fixed << std::setprecision(4) << std::setw(12) << r.seconds
+              << std::setprecision(0) << std::setw(14) << (r.seconds > 0 ? r.events / r.seconds : 0.0)
+              << std::setprecision(1) << std::setw(12) << r.seconds * 1e9 / r.processes
+              << std::setw(14) << r.peakRssKb / 1024.0
+              << std::endl;
+}
+
+/** Escapes a policy name for a JSON string (names contain no control characters). */
+static std::string jsonString(const std::string& text) {
+    std::string escaped = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+/**
+ * Writes one JSON object per line inside a results array, in a fixed order and with fixed precision, so two
+ * runs can be compared with a plain line diff. The simulated metrics are included so behavior changes show up too.
+ */
+static void writeJson(const std::string& filename, const std::vector<BenchmarkResult>& results, uint64_t seed, int repetitions) {
+    std::ofstream out(filename, std::ios::trunc);
+    if (!out) throw std::runtime_error("Error opening file for writing: " + filename);
+
+    out << "{\n  \"seed\": " << seed << ",\n  \"repetitions\": " << repetitions << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& r = results[i];
+        std::ostringstream line;
+        line << std::fixed << "    {\"policy\": " << jsonString(r.policy)
+             << ", \"processes\": " << r.processes
+             << ", \"events\": " << r.events
+             << std::setprecision(6) << ", \"seconds\": " << r.seconds
+             << std::setprecision(0) << ", \"events_per_second\": " << (r.seconds > 0 ? r.events / r.seconds : 0.0)
+             << std::setprecision(2) << ", \"ns_per_process\": " << r.seconds * 1e9 / r.processes
+             << ", \"peak_rss_kb\": " << r.peakRssKb
+             << std::setprecision(4) << ", \"average_waiting_time\": " << r.metrics.averageWaitingTime
+             << ", \"average_turnaround_time\": " << r.metrics.averageTurnaroundTime
+             << ", \"average_response_time\": " << r.metrics.averageResponseTime
+             << ", \"p99_waiting_time\": " << r.metrics.waitingPercentiles.p99
+             << ", \"p99_turnaround_time\": " << r.metrics.turnaroundPercentiles.p99
+             << ", \"p99_response_time\": " << r.metrics.responsePercentiles.p99
+             << ", \"context_switches\": " << r.metrics.contextSwitches
+             << ", \"preemptions\": " << r.metrics.preemptions
+             << ", \"total_elapsed_time\": " << r.metrics.totalElapsedTime << "}";
+        out << line.str() << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    if (!out) throw std::runtime_error("Error writing file: " + filename);
+}
+
+/**
+ * Benchmarks every runX function from Scheduler.h on generated workloads of increasing size.
+ * Reports engine events per second, wall time per simulated process and peak RSS per policy and size,
+ * optionally as JSON (--json FILE) for comparing builds.
+ */
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes = {1000, 10000, 100000, 1000000};
+    int repetitions = 3;
+    std::string jsonFile;
+    MultiCoreConfig multiCore;
+    bool multiCoreMode = false;
+    GeneratorConfig generatorConfig;
+    generatorConfig.seed = 2024;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--sizes" && i + 1 < argc) {
+                sizes = parseParameterList(argv[++i]);
+            } else if (arg == "--repeat" && i + 1 < argc) {
+                repetitions = parseIntegerOption(argv[++i], 0);
+                if (repetitions < 1) throw std::runtime_error("--repeat expects a positive count");
+            } else if (arg == "--cpus" && i + 1 < argc) {
+                multiCore.cores = parseIntegerOption(argv[++i], -1);
+                multiCore.validate();
+                multiCoreMode = true;
+            } else if (arg == "--migration-cost" && i + 1 < argc) {
+                multiCore.migrationCost = parseIntegerOption(argv[++i], -1);
+                multiCore.validate();
+            } else if (arg == "--json" && i + 1 < argc) {
+                jsonFile = argv[++i];
+            } else if (arg.compare(0, 2, "--") == 0 && arg != "--count" && i + 1 < argc && applyGeneratorOption(generatorConfig, arg.substr(2), argv[i + 1])) {
+                ++i;
+            } else {
+                std::cerr << "Usage: " << argv[0] << " [--sizes LIST] [--repeat N] [--cpus N [--migration-cost T]] [--json FILE] [GENERATOR_OPTIONS]" << std::endl;
+                std::cerr << "  --cpus runs every policy on the multi-CPU engine with N CPUs instead of on a single CPU" << std::endl;
+                std::cerr << "  LIST is a value, an inclusive range first:last[:step], or a comma-separated list of those (default 1000,10000,100000,1000000)" << std::endl;
+                std::cerr << "  GENERATOR_OPTIONS are the generate_workload options except --count (default seed 2024)" << std::endl;
+                return 1;
+            }
+        }
+
+        std::vector<BenchmarkPolicy> policies = multiCoreMode ? multiCorePolicies(multiCore) : benchmarkPolicies();
+        std::vector<BenchmarkResult> results;
+        printHeader();
+        for (int size : sizes) {
+            generatorConfig.processCount = size;
+            const Workload processes(generateWorkload(generatorConfig));
+            for (const BenchmarkPolicy& policy : policies) {
+                results.push_back(measure(policy, processes, repetitions));
+                printRow(results.back());
+            }
+        }
+
+        if (!jsonFile.empty()) {
+            writeJson(jsonFile, results, generatorConfig.seed, repetitions);
+            std::cout << "\nWrote " << results.size() << " results to " << jsonFile << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
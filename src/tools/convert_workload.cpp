@@ -0,0 +1,45 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "../Process.h"
+#include "../WorkloadLoader.h"
+#include "../BinaryWorkload.h"
+
+/**
+ * Converts a workload between the text format (ID,ArrivalTime,BurstTime,Priority) and the binary columnar
+ * format. The direction is picked from the input: text input is written as binary, binary input as text.
+ */
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <input_workload> <output_workload>" << std::endl;
+        std::cerr << "  Text input is converted to the binary format, binary input back to text." << std::endl;
+        return 1;
+    }
+
+    std::string input = argv[1];
+    std::string output = argv[2];
+
+    try {
+        bool binaryInput;
+        {
+            MappedFile file(input);
+            binaryInput = isBinaryWorkload(file.data(), file.size());
+        }
+
+        std::vector<Process> processes = loadWorkload(input);
+        if (binaryInput) {
+            saveProcessesToFile(output, processes);
+        } else {
+            saveBinaryWorkload(output, processes);
+        }
+        std::cout << "Converted " << processes.size() << " processes from " << input << " ("
+                  << (binaryInput ? "binary" : "text") << ") to " << output << " ("
+                  << (binaryInput ? "text" : "binary") << ")" << std::endl;
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Conversion failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
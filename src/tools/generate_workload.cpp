@@ -0,0 +1,111 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "../Process.h"
+#include "../WorkloadLoader.h"
+#include "../WorkloadGenerator.h"
+#include "../BinaryWorkload.h"
+
+/** Bytes of formatted lines collected before each write. */
+static const size_t OUTPUT_BUFFER_SIZE = 1 << 20;
+
+/** Writes the stream in the text format to out, formatting into a large buffer rather than per-line ostream calls. */
+static void writeText(GeneratedProcessStream& stream, std::ostream& out) {
+    std::vector<char> buffer(OUTPUT_BUFFER_SIZE + PROCESS_LINE_MAX);
+    size_t used = 0;
+    out << "# ProcessID,ArrivalTime,BurstTime,Priority[,IoBurst,CpuBurst]...\n";
+    Process process(0, 0, 0, 0);
+    while (stream.next(process)) {
+        if (used + processLineMax(process) > buffer.size()) {
+            out.write(buffer.data(), used);
+            used = 0;
+            if (buffer.size() < processLineMax(process)) buffer.resize(processLineMax(process));
+        }
+        used += formatProcessLine(process, buffer.data() + used);
+        if (used >= OUTPUT_BUFFER_SIZE) {
+            out.write(buffer.data(), used);
+            used = 0;
+        }
+    }
+    out.write(buffer.data(), used);
+}
+
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] [output_file | -]" << std::endl;
+    std::cerr << "  --count N                 number of processes (default 1000)" << std::endl;
+    std::cerr << "  --seed S                  random seed (default 1)" << std::endl;
+    std::cerr << "  --arrivals poisson|bursty arrival process (default poisson)" << std::endl;
+    std::cerr << "  --rate R                  arrivals per time unit, outside bursts for bursty (default 0.08)" << std::endl;
+    std::cerr << "  --burst-factor F          bursty: rate multiplier inside a burst (default 20)" << std::endl;
+    std::cerr << "  --burst-run N             bursty: mean arrivals per calm or burst run (default 100)" << std::endl;
+    std::cerr << "  --bursts exponential|pareto|bimodal  CPU burst distribution (default exponential)" << std::endl;
+    std::cerr << "  --mean-burst M            mean burst for exponential and pareto (default 10)" << std::endl;
+    std::cerr << "  --pareto-shape A          pareto tail index, > 1 (default 1.5)" << std::endl;
+    std::cerr << "  --bimodal S:L:F           bimodal short mean, long mean and long fraction (default 4:100:0.1)" << std::endl;
+    std::cerr << "  --max-burst N             cap on a single burst (default 1000000)" << std::endl;
+    std::cerr << "  --io-fraction F           share of processes that alternate CPU and I/O bursts (default 0)" << std::endl;
+    std::cerr << "  --io-bursts N             I/O bursts per such process, each followed by a CPU burst (default 3)" << std::endl;
+    std::cerr << "  --mean-io M               mean I/O burst, exponential (default 20)" << std::endl;
+    std::cerr << "  --priorities P:W,...      priority mix with relative weights (default 1:1,2:1,3:1,4:1,5:1)" << std::endl;
+    std::cerr << "  --threads N               generator threads (default: all cores)" << std::endl;
+    std::cerr << "  --binary                  write the binary workload format instead of text" << std::endl;
+}
+
+/**
+ * Generates a synthetic workload and writes it in the text format (to a file or standard output) or, with
+ * --binary, in the binary workload format. The same options and seed always produce the same workload.
+ */
+int main(int argc, char* argv[]) {
+    GeneratorConfig config;
+    std::string output = "-";
+    unsigned threadCount = 0;
+    bool binary = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--binary") {
+                binary = true;
+            } else if (arg == "--threads" && i + 1 < argc) {
+                int threads = std::stoi(argv[++i]);
+                if (threads < 1) throw std::runtime_error("--threads expects a positive thread count");
+                threadCount = threads;
+            } else if (arg.compare(0, 2, "--") == 0 && i + 1 < argc && applyGeneratorOption(config, arg.substr(2), argv[i + 1])) {
+                ++i;
+            } else if (arg.compare(0, 2, "--") != 0 || arg == "-") {
+                output = arg;
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        if (binary && output == "-") {
+            std::cerr << "--binary needs an output file" << std::endl;
+            return 1;
+        }
+
+        if (binary) {
+            saveBinaryWorkload(output, generateWorkload(config, threadCount));
+        } else {
+            GeneratedProcessStream stream(config, threadCount);
+            if (output == "-") {
+                writeText(stream, std::cout);
+            } else {
+                std::ofstream out(output, std::ios::trunc);
+                if (!out) throw std::runtime_error("Error opening file for writing: " + output);
+                writeText(stream, out);
+                if (!out) throw std::runtime_error("Error writing file: " + output);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Generation failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (output != "-") {
+        std::cerr << "Generated " << config.processCount << " processes into " << output << std::endl;
+    }
+    return 0;
+}